@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoroabstractsocket.h"
+#include "qcorotcpserver.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+
+#include <memory>
+
+namespace {
+
+constexpr int messageCount = 1000;
+
+QCoro::Task<> writeMessages(QTcpSocket &socket, QByteArray message) {
+    for (int i = 0; i < messageCount; ++i) {
+        co_await qCoro(socket).write(message);
+    }
+}
+
+//! Sends messageCount messages over a loopback connection, returns the number of received bytes.
+QCoro::Task<qint64> transfer(int messageSize) {
+    QTcpServer server;
+    server.listen(QHostAddress::LocalHost);
+
+    QTcpSocket client;
+    client.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    std::unique_ptr<QTcpSocket> peer(co_await qCoro(server).waitForNewConnection());
+    co_await qCoro(client).waitForConnected();
+
+    auto writer = writeMessages(client, QByteArray(messageSize, 'x'));
+    const qint64 expected = static_cast<qint64>(messageSize) * messageCount;
+    qint64 received = 0;
+    while (received < expected) {
+        const auto data = co_await qCoro(peer.get()).read(expected - received);
+        received += data.size();
+    }
+    co_await writer;
+    co_return received;
+}
+
+} // namespace
+
+class AbstractSocketBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkLoopback_data() {
+        QTest::addColumn<int>("messageSize");
+        QTest::newRow("16 B") << 16;
+        QTest::newRow("4 KiB") << 4 * 1024;
+        QTest::newRow("64 KiB") << 64 * 1024;
+    }
+
+    void benchmarkLoopback() {
+        QFETCH(int, messageSize);
+
+        qint64 received = 0;
+        QBENCHMARK {
+            received = QCoro::waitFor(transfer(messageSize));
+        }
+        QCOMPARE(received, static_cast<qint64>(messageSize) * messageCount);
+    }
+};
+
+QTEST_GUILESS_MAIN(AbstractSocketBenchmark)
+
+#include "qcoroabstractsocket.moc"
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoroasyncgeneratoroperators.h"
+#include "qcorotask.h"
+
+#include <QCryptographicHash>
+#include <QTest>
+
+namespace {
+
+constexpr int itemCount = 256;
+constexpr int itemSize = 64 * 1024;
+constexpr int hashRounds = 8;
+
+QCoro::AsyncGenerator<QByteArray> payloads() {
+    for (int i = 0; i < itemCount; ++i) {
+        co_yield QByteArray(itemSize, static_cast<char>(i));
+    }
+}
+
+// Deliberately CPU-heavy transformation, so that the benchmark measures the overhead of
+// dispatching the values into the thread pool and delivering the results back.
+QByteArray digest(QByteArray data) {
+    for (int i = 0; i < hashRounds; ++i) {
+        data = QCryptographicHash::hash(data, QCryptographicHash::Sha256).repeated(itemSize / 32);
+    }
+    return data.left(32);
+}
+
+template<typename Generator>
+QCoro::Task<int> consume(Generator generator) {
+    int count = 0;
+    QCORO_FOREACH(const QByteArray &value, generator) {
+        Q_UNUSED(value);
+        ++count;
+    }
+    co_return count;
+}
+
+} // namespace
+
+class AsyncGeneratorOperatorsBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkMap() {
+        QBENCHMARK {
+            const int count = QCoro::waitFor(consume(payloads() | QCoro::map(digest)));
+            QCOMPARE(count, itemCount);
+        }
+    }
+
+    void benchmarkParallelMap_data() {
+        QTest::addColumn<int>("concurrency");
+        QTest::addColumn<bool>("inputOrder");
+
+        for (int concurrency : {1, 2, 4, 8}) {
+            QTest::addRow("%d threads, input order", concurrency) << concurrency << true;
+            QTest::addRow("%d threads, completion order", concurrency) << concurrency << false;
+        }
+    }
+
+    void benchmarkParallelMap() {
+        QFETCH(int, concurrency);
+        QFETCH(bool, inputOrder);
+        const auto order = inputOrder ? QCoro::ResultOrder::InputOrder : QCoro::ResultOrder::CompletionOrder;
+
+        QBENCHMARK {
+            const int count = QCoro::waitFor(
+                consume(payloads() | QCoro::parallelMap(digest, static_cast<std::size_t>(concurrency), order)));
+            QCOMPARE(count, itemCount);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(AsyncGeneratorOperatorsBenchmark)
+
+#include "qcoroasyncgeneratoroperators.moc"
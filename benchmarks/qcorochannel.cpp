@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorochannel.h"
+#include "qcorosignal.h"
+#include "qcorothread.h"
+
+#include <QTest>
+#include <QThread>
+
+class Emitter : public QObject {
+    Q_OBJECT
+Q_SIGNALS:
+    void triggered(int value);
+};
+
+namespace {
+
+constexpr int valueCount = 100'000;
+
+//! Sends the values from the worker thread and closes the channel.
+QCoro::Task<> produce(QCoro::Channel<int> channel, QThread *worker) {
+    auto *mainThread = QThread::currentThread();
+    co_await QCoro::moveToThread(worker);
+    for (int i = 0; i < valueCount; ++i) {
+        co_await channel.send(1);
+    }
+    channel.close();
+    co_await QCoro::moveToThread(mainThread);
+}
+
+QCoro::Task<int> receiveValues(QThread *worker, std::size_t capacity) {
+    QCoro::Channel<int> channel(capacity);
+    auto producer = produce(channel, worker);
+    int total = 0;
+    while (const auto value = co_await channel.receive()) {
+        total += *value;
+    }
+    co_await producer;
+    co_return total;
+}
+
+QCoro::Task<int> receiveBatches(QThread *worker, std::size_t capacity) {
+    QCoro::Channel<int> channel(capacity);
+    auto producer = produce(channel, worker);
+    int total = 0;
+    while (true) {
+        const auto values = co_await channel.receiveMany(capacity);
+        if (values.empty()) {
+            break;
+        }
+        for (const int value : values) {
+            total += value;
+        }
+    }
+    co_await producer;
+    co_return total;
+}
+
+//! Emits the signals from the worker thread.
+QCoro::Task<> emitSignals(Emitter &emitter, QThread *worker) {
+    auto *mainThread = QThread::currentThread();
+    co_await QCoro::moveToThread(worker);
+    for (int i = 0; i < valueCount; ++i) {
+        Q_EMIT emitter.triggered(1);
+    }
+    co_await QCoro::moveToThread(mainThread);
+}
+
+//! Baseline: passing the values as cross-thread signals.
+QCoro::Task<int> receiveSignals(QThread *worker) {
+    Emitter emitter;
+    auto listener = qCoroSignalListener(&emitter, &Emitter::triggered);
+    auto producer = emitSignals(emitter, worker);
+    int total = 0;
+    auto it = co_await listener.begin();
+    while (it != listener.end()) {
+        total += *it;
+        if (total == valueCount) {
+            break;
+        }
+        co_await ++it;
+    }
+    co_await producer;
+    co_return total;
+}
+
+} // namespace
+
+class ChannelBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase() {
+        mWorker.start();
+    }
+
+    void cleanupTestCase() {
+        mWorker.quit();
+        mWorker.wait();
+    }
+
+    void benchmarkCrossThreadReceive_data() {
+        QTest::addColumn<int>("capacity");
+        QTest::newRow("capacity 1") << 1;
+        QTest::newRow("capacity 64") << 64;
+        QTest::newRow("capacity 1024") << 1024;
+    }
+
+    void benchmarkCrossThreadReceive() {
+        QFETCH(int, capacity);
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(receiveValues(&mWorker, static_cast<std::size_t>(capacity)));
+        }
+        QCOMPARE(total, valueCount);
+    }
+
+    void benchmarkCrossThreadReceiveMany_data() {
+        benchmarkCrossThreadReceive_data();
+    }
+
+    void benchmarkCrossThreadReceiveMany() {
+        QFETCH(int, capacity);
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(receiveBatches(&mWorker, static_cast<std::size_t>(capacity)));
+        }
+        QCOMPARE(total, valueCount);
+    }
+
+    void benchmarkCrossThreadSignalListener() {
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(receiveSignals(&mWorker));
+        }
+        QCOMPARE(total, valueCount);
+    }
+
+private:
+    QThread mWorker;
+};
+
+QTEST_GUILESS_MAIN(ChannelBenchmark)
+
+#include "qcorochannel.moc"
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorofuture.h"
+
+#include <QTest>
+#include <QtConcurrentRun>
+
+namespace {
+
+constexpr int futureCount = 100000;
+
+QCoro::Task<int> awaitFutures(int count) {
+    int total = 0;
+    for (int i = 0; i < count; ++i) {
+        total += co_await QtConcurrent::run([i]() { return i % 2; });
+    }
+    co_return total;
+}
+
+} // namespace
+
+class FutureBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkAwaitConcurrentRun() {
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(awaitFutures(futureCount));
+        }
+        QCOMPARE(total, futureCount / 2);
+    }
+};
+
+QTEST_GUILESS_MAIN(FutureBenchmark)
+
+#include "qcorofuture.moc"
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorogenerator.h"
+
+#include <QTest>
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr int lineCount = 10000;
+
+std::vector<std::string> createLines() {
+    std::vector<std::string> lines;
+    lines.reserve(lineCount);
+    for (int i = 0; i < lineCount; ++i) {
+        lines.push_back("key" + std::to_string(i) + " = value " + std::to_string(i * 7) + " ; comment");
+    }
+    return lines;
+}
+
+//! Hand-written iterator over space-separated words, used as a baseline.
+class WordIterator {
+public:
+    explicit WordIterator(std::string_view input)
+        : mInput(input) {
+        advance();
+    }
+
+    bool atEnd() const {
+        return mWord.empty();
+    }
+    std::string_view operator*() const {
+        return mWord;
+    }
+    WordIterator &operator++() {
+        advance();
+        return *this;
+    }
+
+private:
+    void advance() {
+        const auto start = mInput.find_first_not_of(' ');
+        if (start == std::string_view::npos) {
+            mWord = {};
+            return;
+        }
+        const auto end = std::min(mInput.find(' ', start), mInput.size());
+        mWord = mInput.substr(start, end - start);
+        mInput.remove_prefix(end);
+    }
+
+    std::string_view mInput;
+    std::string_view mWord;
+};
+
+template<typename Alloc>
+QCoro::Generator<std::string_view> words(std::allocator_arg_t, const Alloc &, std::string_view input) {
+    for (WordIterator it(input); !it.atEnd(); ++it) {
+        co_yield *it;
+    }
+}
+
+QCoro::Generator<std::string_view> words(std::string_view input) {
+    return words(std::allocator_arg, std::allocator<void>{}, input);
+}
+
+} // namespace
+
+class GeneratorBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase() {
+        mLines = createLines();
+    }
+
+    void benchmarkHandWrittenIterator() {
+        std::size_t total = 0;
+        QBENCHMARK {
+            for (const auto &line : mLines) {
+                for (WordIterator it(line); !it.atEnd(); ++it) {
+                    total += (*it).size();
+                }
+            }
+        }
+        QVERIFY(total > 0);
+    }
+
+    void benchmarkGenerator() {
+        std::size_t total = 0;
+        QBENCHMARK {
+            for (const auto &line : mLines) {
+                for (const auto word : words(line)) {
+                    total += word.size();
+                }
+            }
+        }
+        QVERIFY(total > 0);
+    }
+
+    void benchmarkPooledGenerator() {
+        std::pmr::unsynchronized_pool_resource pool;
+        std::size_t total = 0;
+        QBENCHMARK {
+            for (const auto &line : mLines) {
+                for (const auto word : words(std::allocator_arg, std::pmr::polymorphic_allocator<>(&pool), line)) {
+                    total += word.size();
+                }
+            }
+        }
+        QVERIFY(total > 0);
+    }
+
+    void benchmarkCallerSuppliedStorage() {
+        std::size_t total = 0;
+        QBENCHMARK {
+            for (const auto &line : mLines) {
+                alignas(std::max_align_t) std::byte storage[512];
+                std::pmr::monotonic_buffer_resource resource(storage, sizeof(storage));
+                for (const auto word : words(std::allocator_arg, std::pmr::polymorphic_allocator<>(&resource), line)) {
+                    total += word.size();
+                }
+            }
+        }
+        QVERIFY(total > 0);
+    }
+
+private:
+    std::vector<std::string> mLines;
+};
+
+QTEST_GUILESS_MAIN(GeneratorBenchmark)
+
+#include "qcorogenerator.moc"
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoroimageprovider.h"
+
+#include <QBuffer>
+#include <QImage>
+#include <QTest>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int imageCount = 50;
+constexpr int visibleCount = 10;
+constexpr int scrollSteps = 200;
+
+//! Provider that decodes synthetic PNG thumbnails.
+class ThumbnailProvider final : public QCoro::ImageProvider {
+public:
+    ThumbnailProvider() {
+        for (int i = 0; i < imageCount; ++i) {
+            QImage image(512, 512, QImage::Format_RGB32);
+            image.fill(QColor::fromHsv(i * 360 / imageCount, 255, 255));
+            QBuffer buffer(&mImages.emplace_back());
+            buffer.open(QIODevice::WriteOnly);
+            image.save(&buffer, "PNG");
+        }
+    }
+
+    QCoro::Task<QImage> asyncRequestImage(const QString &id, const QSize &requestedSize) override {
+        co_return co_await decodeImage(mImages[id.toInt()], requestedSize);
+    }
+
+private:
+    std::vector<QByteArray> mImages;
+};
+
+//! Provider that returns ready images, or texture factories built from them.
+class ReadyImageProvider final : public QCoro::ImageProvider {
+public:
+    explicit ReadyImageProvider(bool textureFactory)
+        : mTextureFactory(textureFactory) {
+        mImage.fill(Qt::blue);
+    }
+
+    QCoro::Task<QImage> asyncRequestImage(const QString &, const QSize &) override {
+        co_return mImage;
+    }
+
+    QCoro::Task<std::unique_ptr<QQuickTextureFactory>> asyncRequestTexture(const QString &id, const QSize &requestedSize) override {
+        if (!mTextureFactory) {
+            co_return co_await QCoro::ImageProvider::asyncRequestTexture(id, requestedSize);
+        }
+        co_return std::unique_ptr<QQuickTextureFactory>(QQuickTextureFactory::textureFactoryForImage(mImage));
+    }
+
+private:
+    QImage mImage{1024, 1024, QImage::Format_ARGB32_Premultiplied};
+    bool mTextureFactory;
+};
+
+} // namespace
+
+class ImageProviderBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkScrolling_data() {
+        QTest::addColumn<bool>("cache");
+
+        QTest::newRow("no cache") << false;
+        QTest::newRow("cache") << true;
+    }
+
+    //! Simulates a list of thumbnails scrolled back and forth.
+    /*!
+     * Each scroll step requests all the visible thumbnails and cancels the
+     * requests for the thumbnails scrolled out of the view before they finish.
+     */
+    void benchmarkScrolling() {
+        QFETCH(bool, cache);
+
+        ThumbnailProvider provider;
+        provider.setCacheCapacity(cache ? 64 * 1024 * 1024 : 0);
+        auto *asyncProvider = static_cast<QQuickAsyncImageProvider *>(&provider);
+
+        QBENCHMARK {
+            provider.clearCache();
+            std::vector<std::unique_ptr<QQuickImageResponse>> responses;
+            int finished = 0;
+            for (int step = 0; step < scrollSteps; ++step) {
+                const int first = std::abs((step % (2 * (imageCount - visibleCount))) - (imageCount - visibleCount));
+                for (int i = first; i < first + visibleCount; ++i) {
+                    auto *response = asyncProvider->requestImageResponse(QString::number(i), QSize(128, 128));
+                    connect(response, &QQuickImageResponse::finished, this, [&finished]() { ++finished; });
+                    responses.emplace_back(response);
+                }
+                if (responses.size() > visibleCount) {
+                    responses[responses.size() - visibleCount - 1]->cancel();
+                }
+            }
+            QTRY_COMPARE_WITH_TIMEOUT(finished, static_cast<int>(responses.size()), 60'000);
+        }
+    }
+
+    void benchmarkTextureHandoff_data() {
+        QTest::addColumn<bool>("textureFactory");
+
+        QTest::newRow("image") << false;
+        QTest::newRow("texture factory") << true;
+    }
+
+    //! Measures the time the engine spends on each ready image.
+    /*!
+     * Covers requesting the response and taking over its texture factory, which is
+     * what the engine does for every finished image.
+     */
+    void benchmarkTextureHandoff() {
+        QFETCH(bool, textureFactory);
+
+        ReadyImageProvider provider(textureFactory);
+        auto *asyncProvider = static_cast<QQuickAsyncImageProvider *>(&provider);
+
+        QBENCHMARK {
+            for (int i = 0; i < imageCount; ++i) {
+                std::unique_ptr<QQuickImageResponse> response(
+                    asyncProvider->requestImageResponse(QString::number(i), QSize()));
+                std::unique_ptr<QQuickTextureFactory> factory(response->textureFactory());
+                Q_ASSERT(factory != nullptr);
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(ImageProviderBenchmark)
+
+#include "qcoroimageprovider.moc"
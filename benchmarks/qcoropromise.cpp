@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoropromise.h"
+#include "qcorosignal.h"
+
+#include <QMetaObject>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+#include <utility>
+
+class Emitter : public QObject {
+    Q_OBJECT
+Q_SIGNALS:
+    void triggered(int value);
+};
+
+namespace {
+
+constexpr int callbackCount = 10'000;
+
+//! Invokes the \c callback later from the event loop of the thread of the \c context.
+template<typename Callback>
+void invokeLater(QObject *context, Callback &&callback) {
+    QMetaObject::invokeMethod(context, std::forward<Callback>(callback), Qt::QueuedConnection);
+}
+
+QCoro::Task<int> awaitPromises(QObject *context) {
+    int total = 0;
+    for (int i = 0; i < callbackCount; ++i) {
+        QCoro::Promise<int> promise;
+        invokeLater(context, [promise]() { promise.setValue(1); });
+        total += co_await promise.task();
+    }
+    co_return total;
+}
+
+//! Baseline: a QObject with a signal for every callback.
+QCoro::Task<int> awaitSignals(QObject *context) {
+    int total = 0;
+    for (int i = 0; i < callbackCount; ++i) {
+        auto emitter = std::make_unique<Emitter>();
+        invokeLater(context, [emitter = emitter.get()]() { Q_EMIT emitter->triggered(1); });
+        total += co_await qCoro(emitter.get(), &Emitter::triggered);
+    }
+    co_return total;
+}
+
+} // namespace
+
+class PromiseBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase() {
+        mWorker.start();
+        mWorkerContext = new QObject;
+        mWorkerContext->moveToThread(&mWorker);
+    }
+
+    void cleanupTestCase() {
+        mWorkerContext->deleteLater();
+        mWorker.quit();
+        mWorker.wait();
+    }
+
+    void benchmarkPromise() {
+        QObject context;
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(awaitPromises(&context));
+        }
+        QCOMPARE(total, callbackCount);
+    }
+
+    void benchmarkSignal() {
+        QObject context;
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(awaitSignals(&context));
+        }
+        QCOMPARE(total, callbackCount);
+    }
+
+    void benchmarkPromiseResolvedInThread() {
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(awaitPromises(mWorkerContext));
+        }
+        QCOMPARE(total, callbackCount);
+    }
+
+    void benchmarkSignalEmittedInThread() {
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(awaitSignals(mWorkerContext));
+        }
+        QCOMPARE(total, callbackCount);
+    }
+
+private:
+    QThread mWorker;
+    QObject *mWorkerContext = nullptr;
+};
+
+QTEST_GUILESS_MAIN(PromiseBenchmark)
+
+#include "qcoropromise.moc"
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorosignal.h"
+
+#include <QMetaObject>
+#include <QTest>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+class Emitter : public QObject {
+    Q_OBJECT
+public:
+    //! Emits the signal once control returns to the event loop.
+    void emitLater(int value) {
+        QMetaObject::invokeMethod(this, [this, value]() { Q_EMIT triggered(value); }, Qt::QueuedConnection);
+    }
+
+Q_SIGNALS:
+    void triggered(int value);
+};
+
+namespace {
+
+constexpr int signalCount = 10'000;
+
+QCoro::Task<int> awaitSignals(Emitter &emitter) {
+    int total = 0;
+    for (int i = 0; i < signalCount; ++i) {
+        emitter.emitLater(1);
+        total += co_await qCoro(&emitter, &Emitter::triggered);
+    }
+    co_return total;
+}
+
+QCoro::Task<int> awaitSignalsWithTimeout(Emitter &emitter) {
+    int total = 0;
+    for (int i = 0; i < signalCount; ++i) {
+        emitter.emitLater(1);
+        const auto result = co_await qCoro(&emitter, &Emitter::triggered, 10s);
+        total += result.value_or(0);
+    }
+    co_return total;
+}
+
+QCoro::Task<int> listenToSignals(Emitter &emitter) {
+    for (int i = 0; i < signalCount; ++i) {
+        emitter.emitLater(1);
+    }
+
+    int total = 0;
+    auto listener = qCoroSignalListener(&emitter, &Emitter::triggered);
+    auto it = co_await listener.begin();
+    while (it != listener.end()) {
+        total += *it;
+        if (total == signalCount) {
+            break;
+        }
+        co_await ++it;
+    }
+    co_return total;
+}
+
+} // namespace
+
+class SignalBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkAwaitSignal() {
+        Emitter emitter;
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(awaitSignals(emitter));
+        }
+        QCOMPARE(total, signalCount);
+    }
+
+    void benchmarkAwaitSignalWithTimeout() {
+        Emitter emitter;
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(awaitSignalsWithTimeout(emitter));
+        }
+        QCOMPARE(total, signalCount);
+    }
+
+    void benchmarkSignalListener() {
+        Emitter emitter;
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(listenToSignals(emitter));
+        }
+        QCOMPARE(total, signalCount);
+    }
+};
+
+QTEST_GUILESS_MAIN(SignalBenchmark)
+
+#include "qcorosignal.moc"
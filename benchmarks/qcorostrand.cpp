@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorostrand.h"
+#include "qcorothread.h"
+
+#include <QMutex>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int threadCount = 4;
+constexpr int iterations = 100'000;
+
+struct SharedState {
+    QCoro::Strand strand;
+    QMutex mutex;
+    int counter = 0;
+};
+
+QCoro::Task<> incrementInStrand(SharedState &state, QThread *thread) {
+    auto *mainThread = QThread::currentThread();
+    co_await QCoro::moveToThread(thread);
+    for (int i = 0; i < iterations; ++i) {
+        const auto guard = co_await state.strand.enter();
+        ++state.counter;
+    }
+    co_await QCoro::moveToThread(mainThread);
+}
+
+//! Baseline: the same work guarded by a mutex.
+QCoro::Task<> incrementWithMutex(SharedState &state, QThread *thread) {
+    auto *mainThread = QThread::currentThread();
+    co_await QCoro::moveToThread(thread);
+    for (int i = 0; i < iterations; ++i) {
+        const QMutexLocker locker(&state.mutex);
+        ++state.counter;
+    }
+    co_await QCoro::moveToThread(mainThread);
+}
+
+template<typename Increment>
+QCoro::Task<int> runContended(const std::vector<std::unique_ptr<QThread>> &threads, Increment increment) {
+    SharedState state;
+    std::vector<QCoro::Task<>> tasks;
+    for (const auto &thread : threads) {
+        tasks.push_back(increment(state, thread.get()));
+    }
+    for (auto &task : tasks) {
+        co_await task;
+    }
+    co_return state.counter;
+}
+
+} // namespace
+
+class StrandBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase() {
+        for (int i = 0; i < threadCount; ++i) {
+            mThreads.push_back(std::make_unique<QThread>());
+            mThreads.back()->start();
+        }
+    }
+
+    void cleanupTestCase() {
+        for (auto &thread : mThreads) {
+            thread->quit();
+            thread->wait();
+        }
+        mThreads.clear();
+    }
+
+    void benchmarkUncontendedStrand() {
+        QCoro::Strand strand;
+        QBENCHMARK {
+            QCoro::waitFor([](QCoro::Strand &strand) -> QCoro::Task<> {
+                for (int i = 0; i < iterations; ++i) {
+                    const auto guard = co_await strand.enter();
+                }
+            }(strand));
+        }
+    }
+
+    void benchmarkUncontendedMutex() {
+        QMutex mutex;
+        QBENCHMARK {
+            for (int i = 0; i < iterations; ++i) {
+                const QMutexLocker locker(&mutex);
+            }
+        }
+    }
+
+    void benchmarkContendedStrand() {
+        int counter = 0;
+        QBENCHMARK {
+            counter = QCoro::waitFor(runContended(mThreads, incrementInStrand));
+        }
+        QCOMPARE(counter, threadCount * iterations);
+    }
+
+    void benchmarkContendedMutex() {
+        int counter = 0;
+        QBENCHMARK {
+            counter = QCoro::waitFor(runContended(mThreads, incrementWithMutex));
+        }
+        QCOMPARE(counter, threadCount * iterations);
+    }
+
+private:
+    std::vector<std::unique_ptr<QThread>> mThreads;
+};
+
+QTEST_GUILESS_MAIN(StrandBenchmark)
+
+#include "qcorostrand.moc"
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorotask.h"
+
+#include <QTest>
+
+namespace {
+
+constexpr int taskCount = 100'000;
+
+QCoro::Task<int> ready(int value) {
+    co_return value;
+}
+
+QCoro::Task<int> nested(int depth) {
+    if (depth == 0) {
+        co_return 1;
+    }
+    const int result = co_await nested(depth - 1);
+    co_return result + 1;
+}
+
+QCoro::Task<int> awaitNested(int depth) {
+    int total = 0;
+    for (int i = 0; i < taskCount; ++i) {
+        total += co_await nested(depth);
+    }
+    co_return total;
+}
+
+QCoro::Task<int> awaitThenChain(int length) {
+    int total = 0;
+    for (int i = 0; i < taskCount; ++i) {
+        auto task = ready(0);
+        for (int j = 0; j < length; ++j) {
+            task = task.then([](int value) { return value + 1; });
+        }
+        total += co_await task;
+    }
+    co_return total;
+}
+
+} // namespace
+
+class TaskBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkCreateAndAwait_data() {
+        QTest::addColumn<int>("depth");
+        QTest::newRow("single") << 0;
+        QTest::newRow("nested 10") << 10;
+    }
+
+    void benchmarkCreateAndAwait() {
+        QFETCH(int, depth);
+
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(awaitNested(depth));
+        }
+        QCOMPARE(total, taskCount * (depth + 1));
+    }
+
+    void benchmarkThenChain_data() {
+        QTest::addColumn<int>("length");
+        QTest::newRow("1 callback") << 1;
+        QTest::newRow("10 callbacks") << 10;
+    }
+
+    void benchmarkThenChain() {
+        QFETCH(int, length);
+
+        int total = 0;
+        QBENCHMARK {
+            total = QCoro::waitFor(awaitThenChain(length));
+        }
+        QCOMPARE(total, taskCount * length);
+    }
+};
+
+QTEST_GUILESS_MAIN(TaskBenchmark)
+
+#include "qcorotask.moc"
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorotask.h"
+#include "qcorothread.h"
+
+#include <QTest>
+#include <QThread>
+
+namespace {
+
+constexpr int hopCount = 1000;
+
+//! Moves the coroutine to the worker thread and back to the main thread.
+QCoro::Task<int> hopThreads(QThread *worker) {
+    auto *mainThread = QThread::currentThread();
+    int hops = 0;
+    for (int i = 0; i < hopCount; ++i) {
+        co_await QCoro::moveToThread(worker);
+        co_await QCoro::moveToThread(mainThread);
+        hops += 2;
+    }
+    co_return hops;
+}
+
+} // namespace
+
+class ThreadBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkThreadHop() {
+        QThread worker;
+        worker.start();
+
+        int hops = 0;
+        QBENCHMARK {
+            hops = QCoro::waitFor(hopThreads(&worker));
+        }
+        QCOMPARE(hops, 2 * hopCount);
+
+        worker.quit();
+        worker.wait();
+    }
+};
+
+QTEST_GUILESS_MAIN(ThreadBenchmark)
+
+#include "qcorothread.moc"
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcororatelimit.h"
+#include "qcorotimer.h"
+
+#include <QTest>
+#include <QTimer>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int coroutineCount = 10'000;
+constexpr int tickCount = 100;
+
+QCoro::Task<> sleepWithTimer(std::chrono::milliseconds timeout, int &finished) {
+    QTimer timer;
+    timer.setSingleShot(true);
+    timer.start(timeout);
+    co_await timer;
+    ++finished;
+}
+
+QCoro::Task<> sleepWithQueue(std::chrono::milliseconds timeout, int &finished) {
+    co_await QCoro::sleepFor(timeout);
+    ++finished;
+}
+
+QCoro::Task<> acquire(QCoro::RateLimiter &limiter, int &finished) {
+    co_await limiter.acquire();
+    ++finished;
+}
+
+QCoro::Task<> tickWithTimer(std::chrono::milliseconds period, bool &done) {
+    QTimer timer;
+    timer.setTimerType(Qt::PreciseTimer);
+    timer.start(period);
+    for (int i = 0; i < tickCount; ++i) {
+        co_await qCoro(timer).waitForTimeout();
+    }
+    done = true;
+}
+
+QCoro::Task<> tickWithInterval(std::chrono::milliseconds period, bool &done) {
+    auto ticker = QCoro::interval(period);
+    auto it = co_await ticker.begin();
+    for (int i = 1; i < tickCount; ++i) {
+        co_await ++it;
+    }
+    done = true;
+}
+
+} // namespace
+
+class TimerBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkSleep_data() {
+        QTest::addColumn<bool>("timerQueue");
+
+        QTest::newRow("QTimer per coroutine") << false;
+        QTest::newRow("timer queue") << true;
+    }
+
+    void benchmarkSleep() {
+        QFETCH(bool, timerQueue);
+
+        QBENCHMARK {
+            int finished = 0;
+            for (int i = 0; i < coroutineCount; ++i) {
+                const auto timeout = std::chrono::milliseconds(i % 10);
+                if (timerQueue) {
+                    sleepWithQueue(timeout, finished);
+                } else {
+                    sleepWithTimer(timeout, finished);
+                }
+            }
+            QTRY_COMPARE_WITH_TIMEOUT(finished, coroutineCount, 60'000);
+        }
+    }
+
+    void benchmarkTicks_data() {
+        QTest::addColumn<bool>("interval");
+
+        QTest::newRow("QTimer") << false;
+        QTest::newRow("interval") << true;
+    }
+
+    //! Ideally takes exactly 100 ticks * 2ms, anything above that is overhead and drift.
+    void benchmarkTicks() {
+        QFETCH(bool, interval);
+
+        QBENCHMARK {
+            bool done = false;
+            if (interval) {
+                tickWithInterval(2ms, done);
+            } else {
+                tickWithTimer(2ms, done);
+            }
+            QTRY_VERIFY_WITH_TIMEOUT(done, 60'000);
+        }
+    }
+
+    void benchmarkRateLimiter() {
+        QBENCHMARK {
+            // All the permits are granted within ~100ms
+            QCoro::RateLimiter limiter(coroutineCount, 100ms, 1);
+            int finished = 0;
+            for (int i = 0; i < coroutineCount; ++i) {
+                acquire(limiter, finished);
+            }
+            QTRY_COMPARE_WITH_TIMEOUT(finished, coroutineCount, 60'000);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(TimerBenchmark)
+
+#include "qcorotimer.moc"
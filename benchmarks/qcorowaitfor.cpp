@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorotask.h"
+#include "qcorothread.h"
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTest>
+#include <QThread>
+#include <QThreadPool>
+
+#include <atomic>
+
+namespace {
+
+constexpr int callCount = 1000;
+
+//! Simulates a worker asking the main thread for some data.
+QCoro::Task<int> fetchFromMainThread(QThread *mainThread, int value) {
+    co_await QCoro::moveToThread(mainThread);
+    co_return value * 2;
+}
+
+} // namespace
+
+class WaitForBenchmark : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkWaitFromThreadPool_data() {
+        QTest::addColumn<bool>("blocking");
+
+        QTest::newRow("event loop") << false;
+        QTest::newRow("blocking") << true;
+    }
+
+    void benchmarkWaitFromThreadPool() {
+        QFETCH(bool, blocking);
+        const auto mode = blocking ? QCoro::WaitMode::Blocking : QCoro::WaitMode::EventLoop;
+        auto *mainThread = QThread::currentThread();
+
+        QThreadPool pool;
+        std::atomic<int> total = 0;
+        QBENCHMARK {
+            std::atomic<int> remaining = callCount;
+            for (int i = 0; i < callCount; ++i) {
+                pool.start([&, i]() {
+                    total += QCoro::waitFor(fetchFromMainThread(mainThread, i), mode);
+                    if (--remaining == 0) {
+                        // Wake up the main thread
+                        QMetaObject::invokeMethod(qApp, []() {}, Qt::QueuedConnection);
+                    }
+                });
+            }
+            while (remaining > 0) {
+                QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+            }
+        }
+        QVERIFY(total > 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(WaitForBenchmark)
+
+#include "qcorowaitfor.moc"
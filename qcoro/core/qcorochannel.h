@@ -0,0 +1,603 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorotask.h"
+#include "qcorothread.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace QCoro {
+
+template<typename T>
+class Channel;
+
+/*! \cond internal */
+
+namespace detail {
+
+//! A coroutine suspended in one or more channels.
+struct ChannelWaiter {
+    //! Claims the waiter to resume it. Only the first call succeeds.
+    bool tryClaim() noexcept {
+        return !mClaimed.exchange(true, std::memory_order_acq_rel);
+    }
+
+    std::coroutine_handle<> mCoroutine;
+    //! The thread the coroutine has suspended in, it's resumed in the same thread.
+    QThread *mThread = nullptr;
+    //! Index of the channel that resumed the waiter, for select().
+    std::size_t mIndex = 0;
+    std::atomic<bool> mClaimed{false};
+};
+
+//! Waiters to resume once the channel mutex is unlocked.
+using ChannelWakeups = std::vector<ChannelWaiter *>;
+
+inline void resumeWaiters(const ChannelWakeups &wakeups) {
+    for (auto *waiter : wakeups) {
+        resumeInThread(waiter->mThread, waiter->mCoroutine);
+    }
+}
+
+//! State shared by all copies of a Channel and by the pending operations.
+/*!
+ * The buffer and the waiters are guarded by the mutex, which is only held to move a single
+ * value, so contention is short. A value sent to a channel with waiting receivers is handed
+ * to the receiver directly, bypassing the buffer. A waiting receiver implies an empty buffer
+ * and a waiting sender implies a full buffer.
+ */
+template<typename T>
+class ChannelState {
+public:
+    struct Receiver {
+        ChannelWaiter *waiter;
+        std::optional<T> *slot;
+        std::size_t index;
+    };
+
+    struct Sender {
+        ChannelWaiter *waiter;
+        T *value;
+        bool *accepted;
+    };
+
+    explicit ChannelState(std::size_t capacity)
+        : mBuffer(capacity) {}
+
+    //! Whether a receive would complete without waiting.
+    bool isReadyLocked() const noexcept {
+        return mSize > 0 || !mSenders.empty() || mClosed;
+    }
+
+    //! Takes the next value from the buffer or from a waiting sender.
+    bool tryReceiveLocked(std::optional<T> &out, ChannelWakeups &wakeups) {
+        if (mSize > 0) {
+            out.emplace(pop());
+            // Make room for a waiting sender
+            while (!mSenders.empty()) {
+                const auto sender = mSenders.front();
+                mSenders.pop_front();
+                if (sender.waiter->tryClaim()) {
+                    push(std::move(*sender.value));
+                    *sender.accepted = true;
+                    wakeups.push_back(sender.waiter);
+                    break;
+                }
+            }
+            return true;
+        }
+
+        // Unbuffered channel, take the value directly from the sender
+        while (!mSenders.empty()) {
+            const auto sender = mSenders.front();
+            mSenders.pop_front();
+            if (sender.waiter->tryClaim()) {
+                out.emplace(std::move(*sender.value));
+                *sender.accepted = true;
+                wakeups.push_back(sender.waiter);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Hands the \c value to a waiting receiver or stores it in the buffer.
+    /*!
+     * The \c value is only moved from when this returns \c true.
+     */
+    bool trySendLocked(T &value, ChannelWakeups &wakeups) {
+        while (!mReceivers.empty()) {
+            const auto receiver = mReceivers.front();
+            mReceivers.pop_front();
+            // The receiver may have been resumed by another channel in select()
+            if (receiver.waiter->tryClaim()) {
+                receiver.slot->emplace(std::move(value));
+                receiver.waiter->mIndex = receiver.index;
+                wakeups.push_back(receiver.waiter);
+                return true;
+            }
+        }
+
+        if (mSize < mBuffer.size()) {
+            push(std::move(value));
+            return true;
+        }
+        return false;
+    }
+
+    void removeReceiverLocked(const ChannelWaiter *waiter) {
+        mReceivers.erase(std::remove_if(mReceivers.begin(), mReceivers.end(),
+                                        [waiter](const Receiver &receiver) { return receiver.waiter == waiter; }),
+                         mReceivers.end());
+    }
+
+    void close() {
+        ChannelWakeups wakeups;
+        {
+            QMutexLocker locker(&mMutex);
+            if (mClosed) {
+                return;
+            }
+            mClosed = true;
+            for (const auto &receiver : mReceivers) {
+                if (receiver.waiter->tryClaim()) {
+                    receiver.waiter->mIndex = receiver.index;
+                    wakeups.push_back(receiver.waiter);
+                }
+            }
+            for (const auto &sender : mSenders) {
+                if (sender.waiter->tryClaim()) {
+                    *sender.accepted = false;
+                    wakeups.push_back(sender.waiter);
+                }
+            }
+            mReceivers.clear();
+            mSenders.clear();
+        }
+        resumeWaiters(wakeups);
+    }
+
+    mutable QMutex mMutex;
+    std::deque<Receiver> mReceivers;
+    std::deque<Sender> mSenders;
+    bool mClosed = false;
+
+    std::size_t capacity() const noexcept {
+        return mBuffer.size();
+    }
+
+    std::size_t sizeLocked() const noexcept {
+        return mSize;
+    }
+
+private:
+    void push(T &&value) {
+        mBuffer[(mHead + mSize) % mBuffer.size()].emplace(std::move(value));
+        ++mSize;
+    }
+
+    T pop() {
+        auto &slot = mBuffer[mHead];
+        T value = std::move(*slot);
+        slot.reset();
+        mHead = (mHead + 1) % mBuffer.size();
+        --mSize;
+        return value;
+    }
+
+    //! Ring buffer of fixed capacity
+    std::vector<std::optional<T>> mBuffer;
+    std::size_t mHead = 0;
+    std::size_t mSize = 0;
+};
+
+template<typename T>
+class ChannelSendOperation {
+public:
+    ChannelSendOperation(std::shared_ptr<ChannelState<T>> state, T &&value)
+        : mState(std::move(state)), mValue(std::move(value)) {}
+    Q_DISABLE_COPY_MOVE(ChannelSendOperation)
+
+    bool await_ready() {
+        return trySend();
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+        mWaiter.mCoroutine = awaitingCoroutine;
+        mWaiter.mThread = QThread::currentThread();
+        QMutexLocker locker(&mState->mMutex);
+        if (mState->mClosed) {
+            return false;
+        }
+        ChannelWakeups wakeups;
+        if (mState->trySendLocked(mValue, wakeups)) {
+            mAccepted = true;
+            locker.unlock();
+            resumeWaiters(wakeups);
+            return false;
+        }
+        mState->mSenders.push_back({&mWaiter, &mValue, &mAccepted});
+        return true;
+    }
+
+    //! Returns whether the value was sent, or whether the channel has been closed.
+    bool await_resume() const noexcept {
+        return mAccepted;
+    }
+
+private:
+    bool trySend() {
+        QMutexLocker locker(&mState->mMutex);
+        if (mState->mClosed) {
+            return true;
+        }
+        ChannelWakeups wakeups;
+        mAccepted = mState->trySendLocked(mValue, wakeups);
+        locker.unlock();
+        resumeWaiters(wakeups);
+        return mAccepted;
+    }
+
+    std::shared_ptr<ChannelState<T>> mState;
+    T mValue;
+    bool mAccepted = false;
+    ChannelWaiter mWaiter;
+};
+
+template<typename T>
+class ChannelReceiveOperation {
+public:
+    explicit ChannelReceiveOperation(std::shared_ptr<ChannelState<T>> state)
+        : mState(std::move(state)) {}
+    Q_DISABLE_COPY_MOVE(ChannelReceiveOperation)
+
+    bool await_ready() {
+        QMutexLocker locker(&mState->mMutex);
+        ChannelWakeups wakeups;
+        const bool ready = mState->tryReceiveLocked(mResult, wakeups) || mState->mClosed;
+        locker.unlock();
+        resumeWaiters(wakeups);
+        return ready;
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+        mWaiter.mCoroutine = awaitingCoroutine;
+        mWaiter.mThread = QThread::currentThread();
+        QMutexLocker locker(&mState->mMutex);
+        ChannelWakeups wakeups;
+        if (mState->tryReceiveLocked(mResult, wakeups) || mState->mClosed) {
+            locker.unlock();
+            resumeWaiters(wakeups);
+            return false;
+        }
+        mState->mReceivers.push_back({&mWaiter, &mResult, 0});
+        return true;
+    }
+
+    //! Returns the received value, or an empty optional if the channel has been closed.
+    std::optional<T> await_resume() {
+        return std::move(mResult);
+    }
+
+private:
+    std::shared_ptr<ChannelState<T>> mState;
+    std::optional<T> mResult;
+    ChannelWaiter mWaiter;
+};
+
+template<typename T>
+class ChannelReceiveManyOperation {
+public:
+    ChannelReceiveManyOperation(std::shared_ptr<ChannelState<T>> state, std::size_t maxCount)
+        : mState(std::move(state)), mMaxCount(std::max<std::size_t>(maxCount, 1)) {}
+    Q_DISABLE_COPY_MOVE(ChannelReceiveManyOperation)
+
+    bool await_ready() {
+        QMutexLocker locker(&mState->mMutex);
+        ChannelWakeups wakeups;
+        drainLocked(wakeups);
+        const bool ready = !mResult.empty() || mState->mClosed;
+        locker.unlock();
+        resumeWaiters(wakeups);
+        return ready;
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+        mWaiter.mCoroutine = awaitingCoroutine;
+        mWaiter.mThread = QThread::currentThread();
+        QMutexLocker locker(&mState->mMutex);
+        ChannelWakeups wakeups;
+        drainLocked(wakeups);
+        if (!mResult.empty() || mState->mClosed) {
+            locker.unlock();
+            resumeWaiters(wakeups);
+            return false;
+        }
+        mState->mReceivers.push_back({&mWaiter, &mSlot, 0});
+        return true;
+    }
+
+    //! Returns the received values, or an empty vector if the channel has been closed.
+    std::vector<T> await_resume() {
+        if (mSlot.has_value()) {
+            // Woken up by a sender, take whatever else has been buffered in the meantime
+            mResult.push_back(std::move(*mSlot));
+            QMutexLocker locker(&mState->mMutex);
+            ChannelWakeups wakeups;
+            drainLocked(wakeups);
+            locker.unlock();
+            resumeWaiters(wakeups);
+        }
+        return std::move(mResult);
+    }
+
+private:
+    void drainLocked(ChannelWakeups &wakeups) {
+        std::optional<T> value;
+        while (mResult.size() < mMaxCount && mState->tryReceiveLocked(value, wakeups)) {
+            mResult.push_back(std::move(*value));
+            value.reset();
+        }
+    }
+
+    std::shared_ptr<ChannelState<T>> mState;
+    const std::size_t mMaxCount;
+    std::vector<T> mResult;
+    std::optional<T> mSlot;
+    ChannelWaiter mWaiter;
+};
+
+template<typename... Ts>
+class ChannelSelectOperation {
+public:
+    using result_type = std::variant<std::optional<Ts>...>;
+
+    explicit ChannelSelectOperation(std::shared_ptr<ChannelState<Ts>>... states)
+        : mStates(std::move(states)...) {}
+    Q_DISABLE_COPY_MOVE(ChannelSelectOperation)
+
+    bool await_ready() {
+        return tryReceive(std::index_sequence_for<Ts...>{});
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+        mWaiter.mCoroutine = awaitingCoroutine;
+        mWaiter.mThread = QThread::currentThread();
+        mRegistered = true;
+        return registerWaiter(std::index_sequence_for<Ts...>{});
+    }
+
+    //! Returns the value received from the first ready channel, the index of the variant is the
+    //! index of the channel. An empty optional means that the channel has been closed.
+    result_type await_resume() {
+        if (mRegistered) {
+            unregisterWaiter(std::index_sequence_for<Ts...>{});
+        }
+        return result<0>();
+    }
+
+private:
+    template<std::size_t... Is>
+    bool tryReceive(std::index_sequence<Is...>) {
+        return (tryReceiveFrom<Is>() || ...);
+    }
+
+    template<std::size_t I>
+    bool tryReceiveFrom() {
+        auto &state = *std::get<I>(mStates);
+        QMutexLocker locker(&state.mMutex);
+        ChannelWakeups wakeups;
+        if (!state.tryReceiveLocked(std::get<I>(mSlots), wakeups) && !state.mClosed) {
+            return false;
+        }
+        mWaiter.mIndex = I;
+        locker.unlock();
+        resumeWaiters(wakeups);
+        return true;
+    }
+
+    template<std::size_t... Is>
+    bool registerWaiter(std::index_sequence<Is...>) {
+        // Stops at the first channel that is ready, returns false if the coroutine shouldn't suspend
+        bool suspend = true;
+        ((suspend = registerWaiterIn<Is>()) && ...);
+        return suspend;
+    }
+
+    template<std::size_t I>
+    bool registerWaiterIn() {
+        auto &state = *std::get<I>(mStates);
+        QMutexLocker locker(&state.mMutex);
+        if (state.isReadyLocked()) {
+            // Another channel we are registered in may have already claimed us, then we must
+            // leave the value in this channel and wait to be resumed.
+            if (!mWaiter.tryClaim()) {
+                return true;
+            }
+            ChannelWakeups wakeups;
+            state.tryReceiveLocked(std::get<I>(mSlots), wakeups);
+            mWaiter.mIndex = I;
+            locker.unlock();
+            resumeWaiters(wakeups);
+            return false;
+        }
+        state.mReceivers.push_back({&mWaiter, &std::get<I>(mSlots), I});
+        return true;
+    }
+
+    template<std::size_t... Is>
+    void unregisterWaiter(std::index_sequence<Is...>) {
+        (unregisterWaiterFrom<Is>(), ...);
+    }
+
+    template<std::size_t I>
+    void unregisterWaiterFrom() {
+        auto &state = *std::get<I>(mStates);
+        QMutexLocker locker(&state.mMutex);
+        state.removeReceiverLocked(&mWaiter);
+    }
+
+    template<std::size_t I>
+    result_type result() {
+        if constexpr (I + 1 < sizeof...(Ts)) {
+            if (mWaiter.mIndex != I) {
+                return result<I + 1>();
+            }
+        }
+        return result_type{std::in_place_index<I>, std::move(std::get<I>(mSlots))};
+    }
+
+    std::tuple<std::shared_ptr<ChannelState<Ts>>...> mStates;
+    std::tuple<std::optional<Ts>...> mSlots;
+    ChannelWaiter mWaiter;
+    bool mRegistered = false;
+};
+
+} // namespace detail
+
+/*! \endcond */
+
+//! A bounded multi-producer multi-consumer channel for passing values between coroutines.
+/*!
+ * ```cpp
+ * QCoro::Channel<QByteArray> channel(64);
+ *
+ * QCoro::Task<> producer(QCoro::Channel<QByteArray> channel) {
+ *     while (auto chunk = co_await readChunk()) {
+ *         co_await channel.send(std::move(*chunk)); // Waits while the channel is full
+ *     }
+ *     channel.close();
+ * }
+ *
+ * QCoro::Task<> consumer(QCoro::Channel<QByteArray> channel) {
+ *     while (const auto chunk = co_await channel.receive()) {
+ *         process(*chunk);
+ *     }
+ * }
+ * ```
+ *
+ * Copies of the Channel refer to the same channel. The channel can be used from any thread;
+ * a coroutine waiting in send() or receive() is always resumed in the thread it was suspended in,
+ * from the thread's event loop. The channel must only be awaited from threads with an event loop.
+ */
+template<typename T>
+class Channel {
+public:
+    //! Constructs a channel that buffers at most \c capacity values.
+    /*!
+     * With zero capacity each send() waits until the value is received.
+     */
+    explicit Channel(std::size_t capacity)
+        : d(std::make_shared<detail::ChannelState<T>>(capacity)) {}
+
+    //! Sends the \c value, waiting while the channel is full.
+    /*!
+     * The awaitable resolves to \c true once the value has been stored in the channel or handed
+     * to a receiver, or to \c false if the channel has been closed (the value is dropped).
+     */
+    [[nodiscard]] auto send(T value) const {
+        return detail::ChannelSendOperation<T>{d, std::move(value)};
+    }
+
+    //! Receives the next value, waiting while the channel is empty.
+    /*!
+     * The awaitable resolves to an empty optional once the channel has been closed
+     * and all the buffered values have been received.
+     */
+    [[nodiscard]] auto receive() const {
+        return detail::ChannelReceiveOperation<T>{d};
+    }
+
+    //! Receives up to \c maxCount values at once, waiting while the channel is empty.
+    /*!
+     * Resolves as soon as at least one value is available, with all the values available at that
+     * moment (but at most \c maxCount). Resolves to an empty vector once the channel has been
+     * closed and all the buffered values have been received.
+     */
+    [[nodiscard]] auto receiveMany(std::size_t maxCount) const {
+        return detail::ChannelReceiveManyOperation<T>{d, maxCount};
+    }
+
+    //! Receives the next value if there's one available, without waiting.
+    std::optional<T> tryReceive() const {
+        std::optional<T> result;
+        detail::ChannelWakeups wakeups;
+        {
+            QMutexLocker locker(&d->mMutex);
+            d->tryReceiveLocked(result, wakeups);
+        }
+        detail::resumeWaiters(wakeups);
+        return result;
+    }
+
+    //! Closes the channel.
+    /*!
+     * Waiting senders are resumed with \c false, further values are not accepted. The values
+     * already in the channel can still be received, after which all waiting and further
+     * receives resolve to an empty result.
+     */
+    void close() const {
+        d->close();
+    }
+
+    //! Returns whether the channel has been closed.
+    bool isClosed() const {
+        QMutexLocker locker(&d->mMutex);
+        return d->mClosed;
+    }
+
+    //! Returns the number of buffered values.
+    std::size_t size() const {
+        QMutexLocker locker(&d->mMutex);
+        return d->sizeLocked();
+    }
+
+    //! Returns the maximum number of buffered values.
+    std::size_t capacity() const {
+        return d->capacity();
+    }
+
+private:
+    template<typename... Ts>
+    friend auto select(const Channel<Ts> &...channels);
+
+    std::shared_ptr<detail::ChannelState<T>> d;
+};
+
+//! Waits until any of the \c channels has a value to receive or is closed.
+/*!
+ * ```cpp
+ * const auto result = co_await QCoro::select(requests, control);
+ * if (result.index() == 0) {
+ *     const auto &request = std::get<0>(result); // std::optional<Request>
+ * }
+ * ```
+ *
+ * The awaitable resolves to a \c std::variant of optional values, the index of the variant is
+ * the index of the channel the value was received from. Only a single value is received. An empty
+ * optional means that the channel has been closed. When multiple channels are ready, the first one
+ * in order is used, so closed channels should not be passed to select() again.
+ */
+template<typename... Ts>
+auto select(const Channel<Ts> &...channels) {
+    static_assert(sizeof...(Ts) > 0, "QCoro::select() requires at least one channel");
+    return detail::ChannelSelectOperation<Ts...>{channels.d...};
+}
+
+} // namespace QCoro
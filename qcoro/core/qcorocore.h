@@ -2,9 +2,14 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include "qcorochannel.h"
 #include "qcoroiodevice.h"
 #include "qcoroprocess.h"
+#include "qcoropromise.h"
 #include "qcorosignal.h"
 #include "qcorotimer.h"
+#include "qcororatelimit.h"
+#include "qcorostrand.h"
+#include "qcorotracers.h"
 #include "qcorofuture.h"
 
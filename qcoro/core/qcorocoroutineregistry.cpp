@@ -0,0 +1,10 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorocoroutineregistry.h"
+
+QCoro::detail::registry::Registry &QCoro::detail::registry::Registry::instance() {
+    static auto *registry = new Registry;
+    return *registry;
+}
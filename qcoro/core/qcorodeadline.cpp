@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorodeadline.h"
+
+namespace QCoro::detail {
+
+#ifdef Q_OS_WIN
+DeadlineClock::time_point &threadDeadline() noexcept {
+    static thread_local DeadlineClock::time_point deadline = DeadlineClock::time_point::max();
+    return deadline;
+}
+#else
+constinit thread_local DeadlineClock::time_point currentThreadDeadline = DeadlineClock::time_point::max();
+#endif
+
+} // namespace QCoro::detail
@@ -5,17 +5,70 @@
 #pragma once
 
 #include "qcorotask.h"
+#include "qcoroasyncgenerator.h"
 #include "macros_p.h"
 
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QPromise>
 
 /*! \cond internal */
 
 namespace QCoro::detail {
 
+//! Wakes up a coroutine whenever new results are reported to a QFuture.
+template<typename T>
+class QCoroFutureResultsWatcher {
+public:
+    explicit QCoroFutureResultsWatcher(const QFuture<T> &future)
+        : mFuture(future) {
+        const auto resume = [this]() {
+            if (auto awaitingCoroutine = std::exchange(mAwaitingCoroutine, nullptr)) {
+                awaitingCoroutine.resume();
+            }
+        };
+        QObject::connect(&mWatcher, &QFutureWatcherBase::resultsReadyAt, &mWatcher, resume);
+        QObject::connect(&mWatcher, &QFutureWatcherBase::canceled, &mWatcher, resume);
+        QObject::connect(&mWatcher, &QFutureWatcherBase::finished, &mWatcher, resume);
+        mWatcher.setFuture(mFuture);
+    }
+
+    Q_DISABLE_COPY(QCoroFutureResultsWatcher)
+    QCoroFutureResultsWatcher(QCoroFutureResultsWatcher &&) = delete;
+    QCoroFutureResultsWatcher &operator=(QCoroFutureResultsWatcher &&) = delete;
+    ~QCoroFutureResultsWatcher() = default;
+
+    bool isDone() const {
+        return mFuture.isFinished() || mFuture.isCanceled();
+    }
+
+    //! Suspends until there are more than \c count results or the future is finished.
+    auto waitForResults(int count) noexcept {
+        struct Awaiter {
+            bool await_ready() const noexcept {
+                return mWatcher.mFuture.resultCount() > mCount || mWatcher.isDone();
+            }
+            void await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+                mWatcher.mAwaitingCoroutine = awaitingCoroutine;
+            }
+            void await_resume() const noexcept {}
+
+            QCoroFutureResultsWatcher &mWatcher;
+            int mCount;
+        };
+        return Awaiter{*this, count};
+    }
+
+private:
+    QFuture<T> mFuture;
+    QFutureWatcher<T> mWatcher;
+    std::coroutine_handle<> mAwaitingCoroutine;
+};
+
 template<typename T>
 class QCoroFuture final {
 private:
@@ -33,18 +86,23 @@ private:
         }
 
         void await_suspend(std::coroutine_handle<> awaitingCoroutine) {
-            auto *watcher = new QFutureWatcher<T_>(mContext.get());
+            // The watcher is only created when we really have to wait and it serves as the
+            // context of the connection as well, so that it's the only QObject created per await.
+            // QFuture::then() is not used on purpose: a QFuture can only have a single continuation
+            // (attaching another one overwrites it), so it would break when the same future is
+            // awaited by multiple coroutines, and continuations are not invoked for canceled futures.
+            mWatcher = std::make_unique<QFutureWatcher<T_>>();
             QObject::connect(
-                watcher, &QFutureWatcherBase::finished,
-                mContext.get(), [awaitingCoroutine]() mutable {
-                    // watcher will get deleted with mContext
+                mWatcher.get(), &QFutureWatcherBase::finished,
+                mWatcher.get(), [awaitingCoroutine]() mutable {
+                    // watcher will get deleted together with the awaiter
                     awaitingCoroutine.resume();
                 });
-            watcher->setFuture(mFuture);
+            mWatcher->setFuture(mFuture);
         }
 
     protected:
-        std::unique_ptr<QObject> mContext = std::make_unique<QObject>();
+        std::unique_ptr<QFutureWatcher<T_>> mWatcher;
         QFuture<T_> mFuture;
     };
 
@@ -83,6 +141,23 @@ private:
     };
 
 
+    static AsyncGenerator<T> resultsGenerator(QFuture<T> future) {
+        QCoroFutureResultsWatcher<T> watcher(future);
+        int next = 0;
+        Q_FOREVER {
+            co_await watcher.waitForResults(next);
+            // Yield all the results that have been reported since the last wakeup in one go
+            for (const int count = future.resultCount(); next < count; ++next) {
+                co_yield future.resultAt(next);
+            }
+            if (watcher.isDone() && next == future.resultCount()) {
+                // Rethrows the exception stored in the future, if any
+                future.waitForFinished();
+                co_return;
+            }
+        }
+    }
+
     friend struct awaiter_type<QFuture<T>>;
 
     QFuture<T> mFuture;
@@ -129,6 +204,23 @@ public:
     Task<T> takeResult() requires (!std::is_void_v<T>) {
         co_return std::move(co_await TakeResultOperation<T>{mFuture});
     }
+
+    /*!
+     * \brief Returns a generator that produces results of the future as they are reported.
+     *
+     * This allows processing results of futures that report multiple results (e.g. from
+     * `QtConcurrent::mapped()`) while the future is still running. The results are produced
+     * in the order of their indices. If the future finishes with an exception, it is rethrown
+     * from the generator once all the results reported before the exception are consumed.
+     *
+     * \warning The memory usage is not bounded: all results stay in the result store of the
+     * QFuture until the future is destroyed, even once they have been consumed, and the producer
+     * is not slowed down when the consumer falls behind. Produce the results in a coroutine and
+     * send them into a QCoro::Channel to stream an unbounded number of results.
+     */
+    AsyncGenerator<T> results() requires (!std::is_void_v<T>) {
+        return resultsGenerator(mFuture);
+    }
 };
 
 template<typename T>
@@ -136,6 +228,28 @@ struct awaiter_type<QFuture<T>> {
     using type = typename QCoroFuture<T>::WaitForFinishedOperation;
 };
 
+template<typename T>
+Task<> fulfillPromise(Task<T> task, std::shared_ptr<QPromise<T>> promise) {
+    // Finish the promise as soon as the future gets canceled, so that whoever is
+    // waiting for the future doesn't have to wait for the task to finish as well.
+    QFutureWatcher<T> watcher;
+    QObject::connect(&watcher, &QFutureWatcherBase::canceled, &watcher, [promise]() {
+        promise->finish();
+    });
+    watcher.setFuture(promise->future());
+
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+        } else {
+            promise->addResult(std::move(co_await task));
+        }
+    } catch (...) {
+        promise->setException(std::current_exception());
+    }
+    promise->finish();
+}
+
 } // namespace QCoro::detail
 
 /*! \endcond */
@@ -151,3 +265,24 @@ template<typename T>
 inline auto qCoro(const QFuture<T> &f) noexcept {
     return QCoro::detail::QCoroFuture<T>{f};
 }
+
+namespace QCoro {
+
+//! Returns a QFuture that finishes when the \c task finishes.
+/*!
+ * The result of the task, or the exception thrown from it, is reported to the
+ * future without blocking any thread. When the future is canceled, it finishes
+ * immediately and the result of the task is discarded.
+ *
+ * @see docs/reference/qfuture.md
+ */
+template<typename T>
+inline QFuture<T> toFuture(Task<T> &&task) {
+    auto promise = std::make_shared<QPromise<T>>();
+    auto future = promise->future();
+    promise->start();
+    detail::fulfillPromise(std::move(task), std::move(promise));
+    return future;
+}
+
+} // namespace QCoro
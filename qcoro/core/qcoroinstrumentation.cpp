@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoroinstrumentation.h"
+
+namespace QCoro::detail::instrumentation {
+
+std::atomic<quint64> totalAllocations{0};
+std::atomic<quint64> totalAllocatedBytes{0};
+
+Registry &Registry::instance() {
+    static auto *registry = new Registry;
+    return *registry;
+}
+
+#ifdef Q_OS_WIN
+CoroutineRecord *&currentCoroutine() noexcept {
+    static thread_local CoroutineRecord *record = nullptr;
+    return record;
+}
+
+CoroutineRecord *&allocatedCoroutine() noexcept {
+    static thread_local CoroutineRecord *record = nullptr;
+    return record;
+}
+#else
+constinit thread_local CoroutineRecord *currentCoroutineRecord = nullptr;
+constinit thread_local CoroutineRecord *allocatedCoroutineRecord = nullptr;
+#endif
+
+} // namespace QCoro::detail::instrumentation
@@ -20,7 +20,12 @@ void QCoroIODevice::OperationBase::finish(std::coroutine_handle<> awaitingCorout
     QObject::disconnect(mConn);
     QObject::disconnect(mCloseConn);
     // Delayed trigger
-    QTimer::singleShot(0, [awaitingCoroutine]() mutable { awaitingCoroutine.resume(); });
+    tracing::SuspensionTrace queued;
+    queued.suspended(QCoro::Tracing::SuspensionKind::Queued, awaitingCoroutine);
+    QTimer::singleShot(0, [awaitingCoroutine, queued]() mutable {
+        queued.resumed();
+        awaitingCoroutine.resume();
+    });
 }
 
 QCoroIODevice::ReadOperation::ReadOperation(QIODevice *device, std::function<QByteArray(QIODevice *)> &&resultCb)
@@ -33,6 +38,7 @@ bool QCoroIODevice::ReadOperation::await_ready() const noexcept {
 
 void QCoroIODevice::ReadOperation::await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
     Q_ASSERT(mDevice);
+    mTrace.suspended(QCoro::Tracing::SuspensionKind::IODevice, awaitingCoroutine);
     mConn = QObject::connect(mDevice, &QIODevice::readyRead,
                              std::bind(&ReadOperation::finish, this, awaitingCoroutine));
     mCloseConn =
@@ -41,6 +47,7 @@ void QCoroIODevice::ReadOperation::await_suspend(std::coroutine_handle<> awaitin
 }
 
 QByteArray QCoroIODevice::ReadOperation::await_resume() {
+    mTrace.resumed();
     return mResultCb(mDevice);
 }
 
@@ -81,6 +88,24 @@ QCoro::Task<QByteArray> QCoroIODevice::readLine(qint64 maxSize, std::chrono::mil
     co_return device->readLine(maxSize);
 }
 
+QCoro::Task<QCoro::Expected<QByteArray, QCoro::IOError>> QCoroIODevice::tryReadAll(std::chrono::milliseconds timeout) {
+    const auto device = mDevice;
+    QCORO_CO_TRYV(tryWaitForReadyRead(timeout));
+    co_return device->readAll();
+}
+
+QCoro::Task<QCoro::Expected<QByteArray, QCoro::IOError>> QCoroIODevice::tryRead(qint64 maxSize, std::chrono::milliseconds timeout) {
+    const auto device = mDevice;
+    QCORO_CO_TRYV(tryWaitForReadyRead(timeout));
+    co_return device->read(maxSize);
+}
+
+QCoro::Task<QCoro::Expected<QByteArray, QCoro::IOError>> QCoroIODevice::tryReadLine(qint64 maxSize, std::chrono::milliseconds timeout) {
+    const auto device = mDevice;
+    QCORO_CO_TRYV(tryWaitForReadyRead(timeout));
+    co_return device->readLine(maxSize);
+}
+
 QCoro::Task<qint64> QCoroIODevice::write(const QByteArray &buffer) {
     const auto bytesWritten = mDevice->write(buffer);
     qint64 bytesConfirmed = 0;
@@ -113,6 +138,24 @@ QCoro::Task<bool> QCoroIODevice::waitForReadyRead(std::chrono::milliseconds time
     co_return result.has_value();
 }
 
+QCoro::Task<QCoro::Expected<void, QCoro::IOError>> QCoroIODevice::tryWaitForReadyRead(std::chrono::milliseconds timeout) {
+    if (!mDevice->isReadable()) {
+        co_return Unexpected(IOError::NotReadable);
+    }
+    if (mDevice->bytesAvailable() > 0) {
+        co_return {};
+    }
+
+    const auto result = co_await waitForReadyReadImpl(timeout);
+    if (!result.has_value()) {
+        co_return Unexpected(IOError::Timeout);
+    }
+    if (!*result) {
+        co_return Unexpected(IOError::Closed);
+    }
+    co_return {};
+}
+
 QCoro::Task<std::optional<qint64>> QCoroIODevice::waitForBytesWritten(int timeout_msecs) {
     return waitForBytesWritten(std::chrono::milliseconds(timeout_msecs));
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "qcorotask.h"
+#include "qcoroexpected.h"
 #include "coroutine.h"
 #include "macros_p.h"
 #include "waitoperationbase_p.h"
@@ -14,6 +15,20 @@
 
 class QIODevice;
 
+namespace QCoro {
+
+//! Reason why an operation on a QIODevice has failed, see QCoro::Expected.
+enum class IOError {
+    //! The device is not open for reading.
+    NotReadable,
+    //! The device has been closed while waiting.
+    Closed,
+    //! The operation has timed out.
+    Timeout,
+};
+
+} // namespace QCoro
+
 /*! \cond internal */
 
 namespace QCoro::detail {
@@ -36,6 +51,7 @@ private:
         QMetaObject::Connection mConn;
         QMetaObject::Connection mCloseConn;
         QMetaObject::Connection mFinishedConn;
+        QCORO_NO_UNIQUE_ADDRESS tracing::SuspensionTrace mTrace;
     };
 
 protected:
@@ -134,6 +150,30 @@ public:
     Task<QByteArray> readLine(qint64 maxSize = 0,
                               std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
 
+    /*!
+     * \brief Like readAll(), but reports why no data could be read.
+     *
+     * Returns the data read from the device, or a QCoro::IOError if the device is not readable,
+     * has been closed or if the operation has timed out.
+     */
+    Task<Expected<QByteArray, IOError>> tryReadAll(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    /*!
+     * \brief Like read(), but reports why no data could be read.
+     *
+     * See tryReadAll() for details.
+     */
+    Task<Expected<QByteArray, IOError>> tryRead(qint64 maxSize,
+                                                std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    /*!
+     * \brief Like readLine(), but reports why no data could be read.
+     *
+     * See tryReadAll() for details.
+     */
+    Task<Expected<QByteArray, IOError>> tryReadLine(qint64 maxSize = 0,
+                                                    std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
     // TODO
     //auto bytesAvailable(qint64 minBytes) {
 
@@ -174,6 +214,14 @@ public:
      */
     Task<bool> waitForReadyRead(int timeout_msecs);
 
+    /*!
+     * \brief Like waitForReadyRead(), but reports why the device has not become ready.
+     *
+     * Returns an empty result when data are available for reading, or a QCoro::IOError if the device
+     * is not readable, has been closed or if the operation has timed out.
+     */
+    Task<Expected<void, IOError>> tryWaitForReadyRead(std::chrono::milliseconds timeout);
+
     /*!
      * \brief Co_awaitable equivalent to [`QIODevice::waitForBytesWritten`][qdoc-qiodevice-waitForBytesWritten].
      *
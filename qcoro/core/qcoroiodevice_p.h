@@ -6,10 +6,11 @@
 
 #include <QIODevice>
 #include "qcorocore_export.h"
+#include "qcorotracing.h"
 
 namespace QCoro::detail {
 
-class QCOROCORE_EXPORT WaitSignalHelper : public QObject {
+class QCOROCORE_EXPORT WaitSignalHelper : public QObject, public tracing::IOSignalSource {
     Q_OBJECT
 public:
     explicit WaitSignalHelper(const QIODevice *device, void(QIODevice::*signalFunc)());
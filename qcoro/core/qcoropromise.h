@@ -0,0 +1,283 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorotask.h"
+#include "qcorothread.h"
+
+#include <QThread>
+
+#include <atomic>
+#include <concepts>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace QCoro {
+
+/*! \cond internal */
+
+namespace detail {
+
+template<typename T>
+class PromiseAwaiter;
+
+//! State shared by all copies of a Promise and by its task.
+/*!
+ * The result is written once by whoever resolves the promise first, and published by exchanging
+ * the awaiter pointer for a marker. The task either sees the marker and reads the result without
+ * suspending, or registers itself and is resumed by the thread that publishes the result.
+ */
+template<typename T>
+class PromiseState {
+public:
+    using Value = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    template<typename... Args>
+    bool setValue(Args &&...args) {
+        if (!tryClaim()) {
+            return false;
+        }
+        mValue.emplace(std::forward<Args>(args)...);
+        publish();
+        return true;
+    }
+
+    bool setException(std::exception_ptr exception) {
+        Q_ASSERT(exception != nullptr);
+        if (!tryClaim()) {
+            return false;
+        }
+        mException = std::move(exception);
+        publish();
+        return true;
+    }
+
+    bool isResolved() const noexcept {
+        return mAwaiter.load(std::memory_order_acquire) == resolvedMarker();
+    }
+
+    //! Registers the \c awaiter, returns false if the promise has already been resolved.
+    bool registerAwaiter(PromiseAwaiter<T> *awaiter) noexcept {
+        void *expected = nullptr;
+        return mAwaiter.compare_exchange_strong(expected, awaiter, std::memory_order_acq_rel,
+                                                std::memory_order_acquire);
+    }
+
+    Value takeResult() {
+        if (mException) {
+            std::rethrow_exception(mException);
+        }
+        return std::move(*mValue);
+    }
+
+    void refPromise() noexcept {
+        mPromiseCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void derefPromise() {
+        if (mPromiseCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // Nobody can resolve the promise anymore, don't leave the task waiting forever
+            setException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+        }
+    }
+
+    //! Marks the task as retrieved, returns false if it has been retrieved before.
+    bool retrieveTask() noexcept {
+        return !mTaskRetrieved.exchange(true, std::memory_order_relaxed);
+    }
+
+private:
+    bool tryClaim() noexcept {
+        return !mClaimed.exchange(true, std::memory_order_acq_rel);
+    }
+
+    const void *resolvedMarker() const noexcept {
+        return this;
+    }
+
+    void publish();
+
+    std::optional<Value> mValue;
+    std::exception_ptr mException;
+    //! nullptr, the waiting awaiter or resolvedMarker() once the result has been published
+    std::atomic<void *> mAwaiter{nullptr};
+    std::atomic<bool> mClaimed{false};
+    std::atomic<bool> mTaskRetrieved{false};
+    std::atomic<int> mPromiseCount{1};
+};
+
+template<typename T>
+class PromiseAwaiter {
+public:
+    explicit PromiseAwaiter(PromiseState<T> &state) noexcept
+        : mState(state) {}
+
+    bool await_ready() const noexcept {
+        return mState.isResolved();
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+        mAwaitingCoroutine = awaitingCoroutine;
+        mThread = QThread::currentThread();
+        return mState.registerAwaiter(this);
+    }
+
+    auto await_resume() {
+        return mState.takeResult();
+    }
+
+    void resume() {
+        if (mThread == QThread::currentThread()) {
+            mAwaitingCoroutine.resume();
+        } else {
+            resumeInThread(mThread, mAwaitingCoroutine);
+        }
+    }
+
+private:
+    PromiseState<T> &mState;
+    std::coroutine_handle<> mAwaitingCoroutine;
+    //! The thread the coroutine has suspended in, it's resumed in the same thread.
+    QThread *mThread = nullptr;
+};
+
+template<typename T>
+void PromiseState<T>::publish() {
+    auto *awaiter = mAwaiter.exchange(const_cast<void *>(resolvedMarker()), std::memory_order_acq_rel);
+    if (awaiter != nullptr) {
+        static_cast<PromiseAwaiter<T> *>(awaiter)->resume();
+    }
+}
+
+template<typename T>
+Task<T> awaitPromise(std::shared_ptr<PromiseState<T>> state) {
+    if constexpr (std::is_void_v<T>) {
+        co_await PromiseAwaiter<T>{*state};
+    } else {
+        co_return co_await PromiseAwaiter<T>{*state};
+    }
+}
+
+} // namespace detail
+
+/*! \endcond */
+
+//! A Task that is finished manually, from a callback or from another thread.
+/*!
+ * ```cpp
+ * QCoro::Task<QByteArray> Downloader::fetch(const QUrl &url) {
+ *     QCoro::Promise<QByteArray> promise;
+ *     mClient->get(url.toString().toStdString(), [promise](int status, std::string body) {
+ *         if (status == 200) {
+ *             promise.setValue(QByteArray::fromStdString(body));
+ *         } else {
+ *             promise.setException(std::make_exception_ptr(DownloadError(status)));
+ *         }
+ *     });
+ *     return promise.task();
+ * }
+ * ```
+ *
+ * Copies of a Promise refer to the same promise, so it can be captured by value in callbacks.
+ * Only the first setValue() or setException() call resolves the promise, subsequent calls are
+ * ignored. When the last copy of the Promise is destroyed without resolving it, the task throws
+ * `std::future_error` with `std::future_errc::broken_promise`.
+ *
+ * The promise can be resolved from any thread. The coroutine awaiting the task is resumed in the
+ * thread in which it has suspended: directly from setValue() or setException() when called in the
+ * same thread, otherwise from the thread's event loop.
+ */
+template<typename T = void>
+class Promise {
+public:
+    Promise()
+        : mState(std::make_shared<detail::PromiseState<T>>()) {}
+    Promise(const Promise &other) noexcept
+        : mState(other.mState) {
+        mState->refPromise();
+    }
+    Promise(Promise &&other) noexcept = default;
+    Promise &operator=(const Promise &other) {
+        if (this != &other) {
+            release();
+            mState = other.mState;
+            mState->refPromise();
+        }
+        return *this;
+    }
+    Promise &operator=(Promise &&other) {
+        if (this != &other) {
+            release();
+            mState = std::move(other.mState);
+        }
+        return *this;
+    }
+    ~Promise() {
+        release();
+    }
+
+    //! Returns the task that finishes once the promise is resolved.
+    /*!
+     * The task can only be retrieved once, just like any Task can only be awaited once.
+     *
+     * \throws std::future_error with \c std::future_errc::future_already_retrieved when the task
+     * has already been retrieved from this promise or any of its copies.
+     */
+    Task<T> task() const {
+        if (!mState->retrieveTask()) {
+            throw std::future_error(std::future_errc::future_already_retrieved);
+        }
+        return detail::awaitPromise(mState);
+    }
+
+    //! Finishes the task with the \c value.
+    /*!
+     * Returns false if the promise has already been resolved, in which case the \c value is ignored.
+     */
+    template<typename U = T>
+    requires(!std::is_void_v<T> && std::constructible_from<T, U>)
+    bool setValue(U &&value) const {
+        return mState->setValue(std::forward<U>(value));
+    }
+
+    //! Finishes the task.
+    /*!
+     * Returns false if the promise has already been resolved.
+     */
+    bool setValue() const
+    requires std::is_void_v<T>
+    {
+        return mState->setValue();
+    }
+
+    //! Finishes the task by throwing the \c exception to the awaiting coroutine.
+    /*!
+     * Returns false if the promise has already been resolved, in which case the \c exception is ignored.
+     */
+    bool setException(std::exception_ptr exception) const {
+        return mState->setException(std::move(exception));
+    }
+
+    //! Returns whether the promise has been resolved.
+    bool isResolved() const noexcept {
+        return mState->isResolved();
+    }
+
+private:
+    void release() {
+        if (auto state = std::exchange(mState, nullptr)) {
+            state->derefPromise();
+        }
+    }
+
+    std::shared_ptr<detail::PromiseState<T>> mState;
+};
+
+} // namespace QCoro
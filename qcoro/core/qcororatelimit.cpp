@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcororatelimit.h"
+#include "qcorotimer.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+
+using namespace QCoro;
+using Clock = detail::TimerQueue::Clock;
+
+namespace QCoro::detail {
+
+struct DebouncerState {
+    Clock::duration interval;
+    quint64 generation = 0;
+};
+
+struct ThrottlerState {
+    Clock::duration interval;
+    Clock::time_point nextAllowed;
+    //! Identifies the latest call waiting for the interval to pass.
+    quint64 generation = 0;
+    bool pending = false;
+};
+
+//! Implemented as the generic cell rate algorithm, so that the waiting coroutines don't need a queue.
+struct RateLimiterState {
+    QMutex mutex;
+    //! Time between two permits.
+    Clock::duration emissionInterval;
+    //! How far ahead of the theoretical arrival time a permit can be acquired.
+    Clock::duration burstTolerance;
+    //! Theoretical arrival time of the next permit.
+    Clock::time_point arrivalTime;
+
+    //! Returns the time at which the permit can be acquired, reserving it if \c wait is true
+    //! or if it can be acquired right away.
+    Clock::time_point reserve(Clock::time_point now, bool wait) {
+        QMutexLocker locker(&mutex);
+        const auto arrival = std::max(arrivalTime, now);
+        const auto allowedAt = arrival - burstTolerance;
+        if (wait || allowedAt <= now) {
+            arrivalTime = arrival + emissionInterval;
+        }
+        return allowedAt;
+    }
+};
+
+} // namespace QCoro::detail
+
+Debouncer::Debouncer(std::chrono::milliseconds interval)
+    : d(std::make_shared<detail::DebouncerState>(detail::DebouncerState{interval}))
+{}
+
+Debouncer::~Debouncer() = default;
+
+QCoro::Task<bool> Debouncer::debounce() {
+    // The state is kept alive by the waiting coroutines, should the Debouncer be destroyed.
+    auto state = d;
+    const auto generation = ++state->generation;
+    co_await detail::TimerQueue::waitUntil(Clock::now() + state->interval);
+    co_return generation == state->generation;
+}
+
+Throttler::Throttler(std::chrono::milliseconds interval)
+    : d(std::make_shared<detail::ThrottlerState>(detail::ThrottlerState{interval, {}}))
+{}
+
+Throttler::~Throttler() = default;
+
+QCoro::Task<bool> Throttler::throttle() {
+    auto state = d;
+    const auto now = Clock::now();
+    if (!state->pending && now >= state->nextAllowed) {
+        state->nextAllowed = now + state->interval;
+        co_return true;
+    }
+
+    const auto generation = ++state->generation;
+    state->pending = true;
+    co_await detail::TimerQueue::waitUntil(state->nextAllowed);
+    if (generation != state->generation) {
+        co_return false;
+    }
+
+    state->pending = false;
+    state->nextAllowed = Clock::now() + state->interval;
+    co_return true;
+}
+
+RateLimiter::RateLimiter(int permits, std::chrono::milliseconds interval, int burst)
+    : d(std::make_unique<detail::RateLimiterState>())
+{
+    Q_ASSERT(permits > 0);
+    if (burst <= 0) {
+        burst = permits;
+    }
+    d->emissionInterval = std::chrono::duration_cast<Clock::duration>(interval) / permits;
+    d->burstTolerance = d->emissionInterval * (burst - 1);
+}
+
+RateLimiter::~RateLimiter() = default;
+
+QCoro::Task<> RateLimiter::acquire() {
+    const auto now = Clock::now();
+    const auto allowedAt = d->reserve(now, true);
+    if (allowedAt > now) {
+        co_await detail::TimerQueue::waitUntil(allowedAt);
+    }
+}
+
+bool RateLimiter::tryAcquire() {
+    const auto now = Clock::now();
+    return d->reserve(now, false) <= now;
+}
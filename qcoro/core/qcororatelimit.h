@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorotask.h"
+#include "qcorocore_export.h"
+
+#include <chrono>
+#include <memory>
+
+namespace QCoro {
+
+namespace detail {
+struct DebouncerState;
+struct ThrottlerState;
+struct RateLimiterState;
+} // namespace detail
+
+//! Lets through only the last of a burst of calls.
+/*!
+ * ```cpp
+ * QCoro::Task<> SearchModel::setQuery(QString query) {
+ *     const bool latest = co_await mDebouncer.debounce();
+ *     if (!latest) {
+ *         co_return; // Superseded by a newer query
+ *     }
+ *     co_await search(query);
+ * }
+ * ```
+ *
+ * The Debouncer must only be used from a single thread.
+ */
+class QCOROCORE_EXPORT Debouncer {
+public:
+    explicit Debouncer(std::chrono::milliseconds interval);
+    ~Debouncer();
+
+    //! Waits until no other call to debounce() has been made for the interval.
+    /*!
+     * Resolves to \c true once the interval passes without another call to debounce(),
+     * or to \c false when another call to debounce() has been made in the meantime.
+     */
+    QCoro::Task<bool> debounce();
+
+private:
+    std::shared_ptr<detail::DebouncerState> d;
+};
+
+//! Lets through at most one call per interval.
+/*!
+ * The first call lets through immediately. Calls made within the interval after a call was
+ * let through wait until the interval passes, and only the last of them is let through.
+ *
+ * The Throttler must only be used from a single thread.
+ */
+class QCOROCORE_EXPORT Throttler {
+public:
+    explicit Throttler(std::chrono::milliseconds interval);
+    ~Throttler();
+
+    //! Waits until the call can be let through.
+    /*!
+     * Resolves to \c true when the call is let through, or to \c false when it was
+     * superseded by a newer call.
+     */
+    QCoro::Task<bool> throttle();
+
+private:
+    std::shared_ptr<detail::ThrottlerState> d;
+};
+
+//! Token bucket rate limiter.
+/*!
+ * Allows \c permits acquisitions per \c interval, with bursts of up to \c burst acquisitions.
+ * Coroutines waiting for a permit are resumed in the order in which they called acquire().
+ *
+ * The RateLimiter can be shared by coroutines in multiple threads; each coroutine is resumed
+ * in the thread it called acquire() from.
+ */
+class QCOROCORE_EXPORT RateLimiter {
+public:
+    //! Constructs a rate limiter. If \c burst is 0, it is the same as \c permits.
+    explicit RateLimiter(int permits, std::chrono::milliseconds interval, int burst = 0);
+    ~RateLimiter();
+
+    //! Waits until a permit is available.
+    QCoro::Task<> acquire();
+    //! Acquires a permit if one is available right now, without waiting.
+    bool tryAcquire();
+
+private:
+    std::unique_ptr<detail::RateLimiterState> d;
+};
+
+} // namespace QCoro
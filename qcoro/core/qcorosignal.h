@@ -22,6 +22,9 @@
 
 #include "impl/isqprivatesignal.h"
 
+class QIODevice;
+class QTcpServer;
+
 namespace QCoro::detail {
 
 namespace concepts {
@@ -35,6 +38,19 @@ concept QObject = requires(T *obj) {
 
 } // namespace concepts
 
+//! What a coroutine waiting for a signal of an object of type \c T is reported to be suspended on.
+template<typename T>
+constexpr Tracing::SuspensionKind signalSuspensionKind() noexcept {
+    if constexpr (std::is_base_of_v<QIODevice, T> || std::is_base_of_v<QTcpServer, T>
+                  || std::is_base_of_v<tracing::IOSignalSource, T>) {
+        return Tracing::SuspensionKind::IODevice;
+    } else if constexpr (std::is_base_of_v<QTimer, T>) {
+        return Tracing::SuspensionKind::Timer;
+    } else {
+        return Tracing::SuspensionKind::Signal;
+    }
+}
+
 template<concepts::QObject T, typename FuncPtr>
 class QCoroSignalBase {
 private:
@@ -202,12 +218,14 @@ public:
     }
 
     void await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+        mTrace.suspended(signalSuspensionKind<T>(), awaitingCoroutine);
         this->handleTimeout(awaitingCoroutine);
         mAwaitingCoroutine = awaitingCoroutine;
         setupConnection();
     }
 
     result_type await_resume() {
+        mTrace.resumed();
         return std::move(mResult);
     }
 
@@ -236,6 +254,7 @@ private:
     result_type mResult;
     std::coroutine_handle<> mAwaitingCoroutine;
     std::unique_ptr<QObject> mDummyReceiver;
+    QCORO_NO_UNIQUE_ADDRESS tracing::SuspensionTrace mTrace;
 };
 
 template<concepts::QObject T, typename FuncPtr>
@@ -267,15 +286,18 @@ public:
                 return !mQueue.isValid() || !mQueue.empty();
             }
             void await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+                mTrace.suspended(signalSuspensionKind<T>(), awaitingCoroutine);
                 mQueue.handleTimeout(awaitingCoroutine);
                 mQueue.setAwaiter(awaitingCoroutine);
             }
             result_type await_resume() {
+                mTrace.resumed();
                 return mQueue.dequeue();
             }
 
         private:
             QCoro::detail::QCoroSignalQueue<T, FuncPtr> &mQueue;
+            QCORO_NO_UNIQUE_ADDRESS tracing::SuspensionTrace mTrace;
         };
         return Awaiter{*this};
     }
@@ -348,11 +370,15 @@ QCoroSignalQueue(T *, FuncPtr &&, std::chrono::milliseconds) -> QCoroSignalQueue
  * If the timeout occurs before the signal is emitted, the result of the
  * coroutine is an empty optional. If the \c timeout is -1 the operation
  * will never time out.
+ *
+ * If the awaiting coroutine has a deadline (see QCoro::setDeadline()), the
+ * operation times out at the deadline at the latest.
  */
 template<QCoro::detail::concepts::QObject T, typename FuncPtr>
 inline auto qCoro(T *obj, FuncPtr &&ptr, std::chrono::milliseconds timeout)
     -> QCoro::Task<typename QCoro::detail::QCoroSignal<T, FuncPtr>::result_type> {
-    auto result = co_await QCoro::detail::QCoroSignal(obj, std::forward<FuncPtr>(ptr), timeout);
+    auto result = co_await QCoro::detail::QCoroSignal(obj, std::forward<FuncPtr>(ptr),
+                                                      QCoro::detail::timeoutWithDeadline(timeout));
     co_return std::move(result);
 }
 
@@ -365,12 +391,15 @@ inline auto qCoro(T *obj, FuncPtr &&ptr, std::chrono::milliseconds timeout)
  * returned as a tuple. If the signal has no arguments, then the result
  * of the coroutine is an empty tuple.
  *
+ * The operation never times out, not even at the deadline of the awaiting
+ * coroutine, since there would be no way to report the timeout.
+ *
  * @see docs/reference/coro.md
  */
 template<QCoro::detail::concepts::QObject T, typename FuncPtr>
 inline auto qCoro(T *obj, FuncPtr &&ptr)
     -> QCoro::Task<typename QCoro::detail::QCoroSignal<T, FuncPtr>::result_type::value_type> {
-    auto result = co_await qCoro<T, FuncPtr>(obj, std::forward<FuncPtr>(ptr), std::chrono::milliseconds{-1});
+    auto result = co_await QCoro::detail::QCoroSignal(obj, std::forward<FuncPtr>(ptr), std::chrono::milliseconds{-1});
     co_return std::move(*result);
 }
 
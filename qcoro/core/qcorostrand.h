@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "coroutine.h"
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace QCoro {
+
+class Strand;
+
+namespace detail {
+class StrandEnterOperation;
+} // namespace detail
+
+//! Keeps the coroutine inside of a QCoro::Strand, see Strand::enter().
+/*!
+ * Leaves the strand when destroyed, unless it has been moved from.
+ */
+class StrandGuard {
+public:
+    StrandGuard() = default;
+    StrandGuard(const StrandGuard &) = delete;
+    StrandGuard &operator=(const StrandGuard &) = delete;
+    StrandGuard(StrandGuard &&other) noexcept
+        : mStrand(std::exchange(other.mStrand, nullptr)) {}
+    StrandGuard &operator=(StrandGuard &&other) noexcept {
+        if (this != &other) {
+            leave();
+            mStrand = std::exchange(other.mStrand, nullptr);
+        }
+        return *this;
+    }
+    ~StrandGuard() {
+        leave();
+    }
+
+    //! Leaves the strand, letting the next waiting coroutine in.
+    /*!
+     * The next coroutine is resumed from this call, so this returns once the resumed coroutine
+     * suspends or finishes. If the current coroutine has itself been resumed by a strand, the next
+     * coroutine is resumed only after the current coroutine suspends or finishes instead, so that the
+     * stack doesn't grow with the number of waiting coroutines.
+     */
+    void leave() noexcept;
+
+    //! Returns whether the guard keeps the coroutine inside of a strand.
+    bool ownsStrand() const noexcept {
+        return mStrand != nullptr;
+    }
+
+private:
+    friend class Strand;
+    friend class detail::StrandEnterOperation;
+    explicit StrandGuard(Strand *strand) noexcept
+        : mStrand(strand) {}
+
+    Strand *mStrand = nullptr;
+};
+
+/*! \cond internal */
+
+namespace detail {
+
+class StrandEnterOperation {
+public:
+    explicit StrandEnterOperation(Strand &strand) noexcept
+        : mStrand(strand) {}
+    StrandEnterOperation(const StrandEnterOperation &) = delete;
+    StrandEnterOperation &operator=(const StrandEnterOperation &) = delete;
+
+    bool await_ready() noexcept;
+    bool await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept;
+    StrandGuard await_resume() noexcept;
+
+private:
+    friend class QCoro::Strand;
+
+    Strand &mStrand;
+    std::coroutine_handle<> mAwaitingCoroutine;
+    //! Next waiter in the queue of the strand
+    StrandEnterOperation *mNext = nullptr;
+};
+
+} // namespace detail
+
+/*! \endcond */
+
+//! Runs the coroutines that enter it one at a time, without blocking any thread.
+/*!
+ * ```cpp
+ * QCoro::Task<> Session::handleMessage(Message message) {
+ *     const auto guard = co_await mStrand.enter();
+ *     // Only one coroutine at a time gets here, mState can be used without locking
+ *     mState.apply(message);
+ *     co_await mStorage.save(mState); // The strand is kept across suspensions
+ * }
+ * ```
+ *
+ * A coroutine that enters a busy strand is suspended and queued. When the coroutine inside the
+ * strand leaves it, the next queued coroutine is resumed directly in the thread that left the
+ * strand, so the strand needs no thread or event loop of its own. The queue is lock-free: the
+ * waiting coroutines are linked through their awaiters, so entering the strand never allocates.
+ *
+ * The strand must outlive all coroutines that enter it.
+ */
+class Strand {
+public:
+    Strand() = default;
+    ~Strand() {
+        Q_ASSERT_X(mState.load(std::memory_order_relaxed) == notLocked, "QCoro::Strand",
+                   "Strand destroyed while a coroutine is inside of it");
+    }
+    Strand(const Strand &) = delete;
+    Strand &operator=(const Strand &) = delete;
+    Strand(Strand &&) = delete;
+    Strand &operator=(Strand &&) = delete;
+
+    //! Enters the strand, waiting until the coroutine that is inside of it leaves.
+    /*!
+     * The awaitable resolves to a StrandGuard that keeps the coroutine inside of the strand until
+     * it's destroyed. Coroutines enter the strand in the order in which they have started waiting.
+     *
+     * Note that the coroutine may be resumed in a different thread than the one it was suspended in.
+     */
+    [[nodiscard]] detail::StrandEnterOperation enter() noexcept {
+        return detail::StrandEnterOperation{*this};
+    }
+
+    //! Enters the strand if no other coroutine is inside of it, without waiting.
+    [[nodiscard]] std::optional<StrandGuard> tryEnter() noexcept {
+        if (tryLock()) {
+            return StrandGuard{this};
+        }
+        return std::nullopt;
+    }
+
+private:
+    friend class StrandGuard;
+    friend class detail::StrandEnterOperation;
+
+    // The state is either notLocked, lockedNoWaiters or a pointer to the most recently queued waiter,
+    // forming a stack of waiters linked by mNext that have arrived since the owner last looked.
+    static constexpr std::uintptr_t notLocked = 1;
+    static constexpr std::uintptr_t lockedNoWaiters = 0;
+
+    bool tryLock() noexcept {
+        auto expected = notLocked;
+        return mState.compare_exchange_strong(expected, lockedNoWaiters, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    //! Acquires the strand, or queues the \c waiter if it's busy. Returns whether it was acquired.
+    bool lockOrEnqueue(detail::StrandEnterOperation *waiter) noexcept {
+        auto state = mState.load(std::memory_order_relaxed);
+        while (true) {
+            if (state == notLocked) {
+                if (mState.compare_exchange_weak(state, lockedNoWaiters, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                    return true;
+                }
+            } else {
+                waiter->mNext = reinterpret_cast<detail::StrandEnterOperation *>(state);
+                if (mState.compare_exchange_weak(state, reinterpret_cast<std::uintptr_t>(waiter),
+                                                 std::memory_order_release, std::memory_order_relaxed)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    //! Passes the strand to the next waiter, or unlocks it if there's none.
+    void unlock() noexcept {
+        if (mWaiters == nullptr) {
+            auto expected = lockedNoWaiters;
+            if (mState.compare_exchange_strong(expected, notLocked, std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+                return;
+            }
+
+            // Take all the newly queued waiters and reverse them, so they are resumed in FIFO order
+            auto *waiter = reinterpret_cast<detail::StrandEnterOperation *>(
+                mState.exchange(lockedNoWaiters, std::memory_order_acquire));
+            Q_ASSERT(waiter != nullptr);
+            while (waiter != nullptr) {
+                auto *next = waiter->mNext;
+                waiter->mNext = mWaiters;
+                mWaiters = waiter;
+                waiter = next;
+            }
+        }
+
+        // The strand stays locked and is now owned by the resumed coroutine
+        auto *waiter = mWaiters;
+        mWaiters = waiter->mNext;
+        resume(waiter);
+    }
+
+    //! Resumes the \c waiter, or queues it if this thread is already resuming a waiter of any strand.
+    /*!
+     * The outermost resume() keeps resuming the queued waiters once the previous one suspends or
+     * finishes. Without it, waiters that leave the strand without suspending would each resume the
+     * next waiter from within their own resumption, nesting as deep as the queue is long.
+     */
+    static void resume(detail::StrandEnterOperation *waiter) noexcept {
+        struct ReadyQueue {
+            detail::StrandEnterOperation *head = nullptr;
+            detail::StrandEnterOperation *tail = nullptr;
+            bool resuming = false;
+        };
+        static thread_local ReadyQueue ready;
+
+        // The waiter is no longer in the queue of the strand, so mNext can link the ready queue
+        waiter->mNext = nullptr;
+        if (ready.resuming) {
+            if (ready.tail != nullptr) {
+                ready.tail->mNext = waiter;
+            } else {
+                ready.head = waiter;
+            }
+            ready.tail = waiter;
+            return;
+        }
+
+        ready.resuming = true;
+        waiter->mAwaitingCoroutine.resume();
+        while (ready.head != nullptr) {
+            // The awaiter is destroyed once its coroutine resumes, so unlink it first
+            waiter = std::exchange(ready.head, ready.head->mNext);
+            if (ready.head == nullptr) {
+                ready.tail = nullptr;
+            }
+            waiter->mAwaitingCoroutine.resume();
+        }
+        ready.resuming = false;
+    }
+
+    std::atomic<std::uintptr_t> mState{notLocked};
+    //! Waiters in FIFO order, only accessed by the owner of the strand
+    detail::StrandEnterOperation *mWaiters = nullptr;
+};
+
+inline void StrandGuard::leave() noexcept {
+    if (auto *strand = std::exchange(mStrand, nullptr)) {
+        strand->unlock();
+    }
+}
+
+namespace detail {
+
+inline bool StrandEnterOperation::await_ready() noexcept {
+    return mStrand.tryLock();
+}
+
+inline bool StrandEnterOperation::await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+    mAwaitingCoroutine = awaitingCoroutine;
+    return !mStrand.lockOrEnqueue(this);
+}
+
+inline StrandGuard StrandEnterOperation::await_resume() noexcept {
+    return StrandGuard{&mStrand};
+}
+
+} // namespace detail
+
+} // namespace QCoro
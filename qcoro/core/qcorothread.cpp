@@ -5,6 +5,8 @@
 #include "qcorothread.h"
 #include "qcorosignal.h"
 
+#include <QAbstractEventDispatcher>
+#include <QDebug>
 #include <QThread>
 #include <QEvent>
 #include <QCoreApplication>
@@ -49,6 +51,7 @@ public:
 
     QThread *mThread;
     std::unique_ptr<ContextHelper> mContext;
+    QCORO_NO_UNIQUE_ADDRESS tracing::SuspensionTrace mTrace;
 };
 
 } // namespace QCoro::detail
@@ -68,6 +71,7 @@ bool ThreadContext::await_ready() const noexcept {
 }
 
 void ThreadContext::await_suspend(std::coroutine_handle<> awaiter) noexcept {
+    d->mTrace.suspended(Tracing::SuspensionKind::Thread, awaiter);
     d->mContext = std::make_unique<ContextHelper>(awaiter, d->mThread);
     d->mContext->moveToThread(d->mThread);
     qCoro(d->mThread).waitForStarted().then([this]() {
@@ -76,8 +80,27 @@ void ThreadContext::await_suspend(std::coroutine_handle<> awaiter) noexcept {
     });
 }
 
-void ThreadContext::await_resume() noexcept {}
+void ThreadContext::await_resume() noexcept {
+    d->mTrace.resumed();
+}
+
 
+void QCoro::detail::resumeInThread(QThread *thread, std::coroutine_handle<> coroutine) {
+    auto *dispatcher = QAbstractEventDispatcher::instance(thread);
+    if (dispatcher == nullptr) {
+        // There's no way to get into a thread without an event loop, resuming right here is only
+        // correct when we are already in it.
+        if (thread != QThread::currentThread()) {
+            qWarning() << "QCoro: Cannot resume a coroutine in thread" << thread
+                       << "which has no event dispatcher, resuming it in thread" << QThread::currentThread()
+                       << "instead.";
+        }
+        coroutine.resume();
+        return;
+    }
+    // The event dispatcher lives in the thread, so the functor is invoked from the thread's event loop
+    QMetaObject::invokeMethod(dispatcher, [coroutine]() mutable { coroutine.resume(); }, Qt::QueuedConnection);
+}
 
 ThreadContext QCoro::moveToThread(QThread *thread) {
     return ThreadContext(thread);
@@ -50,6 +50,13 @@ ThreadContext moveToThread(QThread *thread);
 
 namespace QCoro::detail {
 
+//! Resumes the \c coroutine from the event loop of the \c thread.
+/*!
+ * The coroutine is resumed immediately in the current thread if the \c thread has no
+ * event dispatcher, with a warning unless the \c thread is the current thread.
+ */
+QCOROCORE_EXPORT void resumeInThread(QThread *thread, std::coroutine_handle<> coroutine);
+
 class QCOROCORE_EXPORT QCoroThread {
 public:
     explicit QCoroThread(QThread *thread);
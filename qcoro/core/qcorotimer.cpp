@@ -8,8 +8,174 @@
 #include <QMetaObject>
 #include <QPointer>
 
+#include <algorithm>
+#include <deque>
+#include <map>
+
 using namespace QCoro::detail;
 
+namespace {
+
+class ThreadTimerQueue {
+public:
+    using Clock = TimerQueue::Clock;
+
+    explicit ThreadTimerQueue(Qt::TimerType timerType) {
+        mTimer.setSingleShot(true);
+        mTimer.setTimerType(timerType);
+        QObject::connect(&mTimer, &QTimer::timeout, &mTimer, [this]() { resumeExpired(); });
+    }
+
+    void add(Clock::time_point deadline, std::coroutine_handle<> coroutine) {
+        const bool earliest = mQueue.empty() || deadline < mQueue.begin()->first;
+        mQueue.emplace(deadline, coroutine);
+        if (earliest) {
+            rearm();
+        }
+    }
+
+    //! Removes a coroutine that is destroyed while waiting.
+    void remove(Clock::time_point deadline, std::coroutine_handle<> coroutine) {
+        const auto [first, last] = mQueue.equal_range(deadline);
+        if (const auto it = std::find_if(first, last, [coroutine](const auto &entry) { return entry.second == coroutine; });
+            it != last) {
+            const bool earliest = it == mQueue.begin();
+            mQueue.erase(it);
+            if (earliest) {
+                rearm();
+            }
+            return;
+        }
+
+        // The deadline has already expired, but the coroutine may be destroyed by another
+        // expired coroutine before it is resumed
+        if (const auto it = std::find(mExpired.begin(), mExpired.end(), coroutine); it != mExpired.end()) {
+            mExpired.erase(it);
+        }
+    }
+
+private:
+    void resumeExpired() {
+        // Coroutines that start waiting again while being resumed are only resumed in the next round
+        const auto end = mQueue.upper_bound(Clock::now());
+        for (auto it = mQueue.begin(); it != end; ++it) {
+            mExpired.push_back(it->second);
+        }
+        mQueue.erase(mQueue.begin(), end);
+
+        // Rearm before resuming anything: a resumed coroutine may spin a nested event loop
+        // (e.g. QCoro::waitFor() or QDialog::exec()) and wait for the remaining deadlines in it.
+        // The nested round then resumes the rest of the expired coroutines, too.
+        rearm();
+        while (!mExpired.empty()) {
+            const auto coroutine = mExpired.front();
+            mExpired.pop_front();
+            coroutine.resume();
+        }
+    }
+
+    void rearm() {
+        if (mQueue.empty()) {
+            mTimer.stop();
+            return;
+        }
+        const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(mQueue.begin()->first - Clock::now());
+        mTimer.start(std::max(timeout, std::chrono::milliseconds::zero()));
+    }
+
+    QTimer mTimer;
+    std::multimap<Clock::time_point, std::coroutine_handle<>> mQueue;
+    //! Coroutines whose deadline has expired that are yet to be resumed.
+    std::deque<std::coroutine_handle<>> mExpired;
+};
+
+ThreadTimerQueue &threadTimerQueue(Qt::TimerType timerType) {
+    switch (timerType) {
+    case Qt::PreciseTimer: {
+        thread_local ThreadTimerQueue queue(Qt::PreciseTimer);
+        return queue;
+    }
+    case Qt::CoarseTimer: {
+        thread_local ThreadTimerQueue queue(Qt::CoarseTimer);
+        return queue;
+    }
+    case Qt::VeryCoarseTimer: {
+        thread_local ThreadTimerQueue queue(Qt::VeryCoarseTimer);
+        return queue;
+    }
+    }
+    Q_UNREACHABLE();
+}
+
+QCoro::AsyncGenerator<std::chrono::steady_clock::time_point> intervalGenerator(
+    TimerQueue::Clock::time_point start, std::chrono::milliseconds period, QCoro::MissedTickPolicy policy,
+    Qt::TimerType timerType) {
+    using Clock = TimerQueue::Clock;
+    auto next = start + period;
+    Q_FOREVER {
+        // The tick was missed either because processing the previous tick took longer than
+        // the period, or because the consumer started iterating the generator late
+        if (const auto now = Clock::now(); next <= now) {
+            switch (policy) {
+            case QCoro::MissedTickPolicy::Skip:
+                next += ((now - next) / period + 1) * period;
+                break;
+            case QCoro::MissedTickPolicy::Burst:
+                break;
+            case QCoro::MissedTickPolicy::Delay:
+                next = now + period;
+                break;
+            }
+        }
+
+        // Missed ticks in the burst mode are produced without waiting
+        if (next > Clock::now()) {
+            co_await TimerQueue::waitUntil(next, timerType);
+        }
+        co_yield next;
+        next += period;
+    }
+}
+
+} // namespace
+
+TimerQueue::WaitUntilOperation::WaitUntilOperation(Clock::time_point deadline, Qt::TimerType timerType)
+    : mDeadline(deadline), mTimerType(timerType) {}
+
+TimerQueue::WaitUntilOperation::~WaitUntilOperation() {
+    if (mAwaitingCoroutine) {
+        threadTimerQueue(mTimerType).remove(mDeadline, mAwaitingCoroutine);
+    }
+}
+
+bool TimerQueue::WaitUntilOperation::await_ready() const noexcept {
+    return false;
+}
+
+void TimerQueue::WaitUntilOperation::await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+    mTrace.suspended(QCoro::Tracing::SuspensionKind::Timer, awaitingCoroutine);
+    mAwaitingCoroutine = awaitingCoroutine;
+    threadTimerQueue(mTimerType).add(mDeadline, awaitingCoroutine);
+}
+
+void TimerQueue::WaitUntilOperation::await_resume() noexcept {
+    mAwaitingCoroutine = nullptr;
+    mTrace.resumed();
+}
+
+TimerQueue::WaitUntilOperation TimerQueue::waitUntil(Clock::time_point deadline, Qt::TimerType timerType) {
+    return WaitUntilOperation{deadline, timerType};
+}
+
+QCoro::AsyncGenerator<std::chrono::steady_clock::time_point> QCoro::interval(
+    std::chrono::milliseconds period, MissedTickPolicy policy, Qt::TimerType timerType) {
+    Q_ASSERT(period > std::chrono::milliseconds::zero());
+
+    // The generator body only starts running on the first begin(), so the start of the
+    // grid of ticks must be taken here
+    return intervalGenerator(TimerQueue::Clock::now(), period, policy, timerType);
+}
+
 QCoroTimer::WaitForTimeoutOperation::WaitForTimeoutOperation(QTimer *timer)
     : mTimer(timer) {}
 
@@ -21,6 +187,7 @@ bool QCoroTimer::WaitForTimeoutOperation::await_ready() const noexcept {
 }
 
 void QCoroTimer::WaitForTimeoutOperation::await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+    mTrace.suspended(QCoro::Tracing::SuspensionKind::Timer, awaitingCoroutine);
     if (mTimer && mTimer->isActive()) {
         mConn = QObject::connect(mTimer, &QTimer::timeout, [this, awaitingCoroutine]() mutable {
             QObject::disconnect(mConn);
@@ -31,7 +198,9 @@ void QCoroTimer::WaitForTimeoutOperation::await_suspend(std::coroutine_handle<>
     }
 }
 
-void QCoroTimer::WaitForTimeoutOperation::await_resume() const {}
+void QCoroTimer::WaitForTimeoutOperation::await_resume() const {
+    mTrace.resumed();
+}
 
 QCoroTimer::QCoroTimer(QTimer *timer)
     : mTimer(timer) {}
@@ -5,12 +5,15 @@
 #pragma once
 
 #include "qcorotask.h"
+#include "qcoroasyncgenerator.h"
 #include "qcorocore_export.h"
 
 #include <QMetaObject>
 #include <QPointer>
 #include <QTimer>
 
+#include <chrono>
+
 /*! \cond internal */
 
 namespace QCoro::detail {
@@ -28,6 +31,7 @@ private:
     private:
         QMetaObject::Connection mConn;
         QPointer<QTimer> mTimer;
+        QCORO_NO_UNIQUE_ADDRESS mutable tracing::SuspensionTrace mTrace;
     };
 
     friend struct awaiter_type<QTimer *>;
@@ -50,19 +54,84 @@ struct awaiter_type<QTimer> {
     using type = QCoroTimer::WaitForTimeoutOperation;
 };
 
+//! Per-thread queue of coroutines waiting for a deadline.
+/*!
+ * All the waiting coroutines in a thread share a single timer (one for each timer type), which
+ * is always set to the earliest deadline in the queue. Coroutines with the same deadline are resumed in the order
+ * in which they started waiting.
+ */
+class QCOROCORE_EXPORT TimerQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class QCOROCORE_EXPORT WaitUntilOperation {
+    public:
+        explicit WaitUntilOperation(Clock::time_point deadline, Qt::TimerType timerType);
+        //! Removes the awaiting coroutine from the queue if it is destroyed while waiting.
+        ~WaitUntilOperation();
+        WaitUntilOperation(WaitUntilOperation &&) noexcept = default;
+        WaitUntilOperation &operator=(WaitUntilOperation &&) noexcept = default;
+        Q_DISABLE_COPY(WaitUntilOperation)
+
+        //! Always suspends, so that the coroutine yields to the event loop even if the deadline has passed.
+        bool await_ready() const noexcept;
+        void await_suspend(std::coroutine_handle<> awaitingCoroutine);
+        void await_resume() noexcept;
+
+    private:
+        Clock::time_point mDeadline;
+        Qt::TimerType mTimerType;
+        //! The suspended coroutine, null when not waiting.
+        std::coroutine_handle<> mAwaitingCoroutine;
+        QCORO_NO_UNIQUE_ADDRESS mutable tracing::SuspensionTrace mTrace;
+    };
+
+    //! Suspends the awaiting coroutine until given \c deadline.
+    /*!
+     * The coroutine is resumed from the event loop of the current thread. If the waiting coroutine
+     * is destroyed (e.g. an AsyncGenerator that is destroyed while it's waiting), it is removed
+     * from the queue. The coroutine must be destroyed in the thread it is waiting in.
+     */
+    static WaitUntilOperation waitUntil(Clock::time_point deadline, Qt::TimerType timerType = Qt::PreciseTimer);
+};
+
 } // namespace QCoro::detail
 
 namespace QCoro {
 
 //! A coroutine that suspends for given period of time.
+/*!
+ * All sleeping coroutines in a thread share a single timer.
+ */
 template<typename Rep, typename Period>
 QCoro::Task<> sleepFor(const std::chrono::duration<Rep, Period> &timeout) {
-    QTimer timer;
-    timer.setSingleShot(true);
-    timer.start(std::chrono::duration_cast<std::chrono::milliseconds>(timeout));
-    co_await timer;
+    co_await detail::TimerQueue::waitUntil(
+        detail::TimerQueue::Clock::now()
+        + std::chrono::duration_cast<detail::TimerQueue::Clock::duration>(timeout));
 }
 
+//! Specifies what QCoro::interval() does when the consumer doesn't keep up with the ticks.
+enum class MissedTickPolicy {
+    //! Missed ticks are skipped, the next tick happens at the next multiple of the period.
+    Skip,
+    //! Missed ticks are produced immediately, one after another, until the ticker catches up.
+    Burst,
+    //! The next tick happens one period after the consumer asks for it, shifting all future ticks.
+    Delay
+};
+
+//! Produces a tick every \c period.
+/*!
+ * Each tick is the time point at which it was scheduled. The ticks are scheduled relative
+ * to the time interval() was called rather than to the previous tick, so the ticker doesn't
+ * drift. This is also the case when the generator is iterated later than that: the ticks
+ * that are due by then are handled as missed. When the consumer takes longer than the period
+ * to process a tick, the missed ticks are handled according to the \c policy.
+ */
+QCOROCORE_EXPORT QCoro::AsyncGenerator<std::chrono::steady_clock::time_point> interval(
+    std::chrono::milliseconds period, MissedTickPolicy policy = MissedTickPolicy::Skip,
+    Qt::TimerType timerType = Qt::PreciseTimer);
+
 //! A coroutine that suspends until the specified time.
 template<typename Clock, typename Duration>
 QCoro::Task<> sleepUntil(const std::chrono::time_point<Clock, Duration> &when) {
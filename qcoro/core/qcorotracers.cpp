@@ -0,0 +1,294 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorotracers.h"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <vector>
+
+using namespace QCoro;
+
+namespace {
+
+void updateMin(std::atomic<quint64> &min, quint64 value) noexcept {
+    auto current = min.load(std::memory_order_relaxed);
+    while (value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+void updateMax(std::atomic<quint64> &max, quint64 value) noexcept {
+    auto current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+QString formatDuration(std::chrono::nanoseconds duration) {
+    return QString::number(std::chrono::duration<double, std::micro>(duration).count(), 'f', 1);
+}
+
+} // namespace
+
+std::atomic<Tracer *> QCoro::detail::tracing::currentTracer{nullptr};
+
+void QCoro::Tracing::setTracer(Tracer *tracer) noexcept {
+    detail::tracing::currentTracer.store(tracer, std::memory_order_release);
+}
+
+Tracer *QCoro::Tracing::tracer() noexcept {
+    return detail::tracing::currentTracer.load(std::memory_order_acquire);
+}
+
+namespace QCoro::detail {
+
+struct ChromeTraceTracerPrivate {
+    struct Span {
+        Tracing::SuspensionKind kind;
+        const void *coroutine;
+        Qt::HANDLE suspendedThread;
+        Qt::HANDLE resumedThread;
+        std::chrono::steady_clock::time_point suspendedAt;
+        std::chrono::steady_clock::time_point resumedAt;
+    };
+
+    explicit ChromeTraceTracerPrivate(std::size_t maxEvents)
+        : maxEvents(maxEvents)
+    {}
+
+    mutable QMutex mutex;
+    const std::size_t maxEvents;
+    //! All timestamps in the trace are relative to this.
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<Span> spans;
+    std::size_t dropped = 0;
+};
+
+} // namespace QCoro::detail
+
+// The index of the bucket is the index of the sub-bucket plus an offset for the magnitude of the
+// value. Values below subBucketCount map directly onto the first buckets, larger values are shifted
+// right until they fit into the upper half of the sub-buckets, and each shift adds another half
+// of the sub-buckets.
+std::size_t LatencyHistogram::bucketIndex(quint64 value) noexcept {
+    if (value < static_cast<quint64>(subBucketCount)) {
+        return static_cast<std::size_t>(value);
+    }
+    const int magnitude = 63 - std::countl_zero(value);
+    const int shift = magnitude - subBucketBits + 1;
+    return static_cast<std::size_t>(shift) * subBucketHalfCount + static_cast<std::size_t>(value >> shift);
+}
+
+quint64 LatencyHistogram::bucketUpperBound(std::size_t index) noexcept {
+    if (index < static_cast<std::size_t>(subBucketCount)) {
+        return index;
+    }
+    const auto shift = static_cast<int>(index / subBucketHalfCount) - 1;
+    const auto subBucket = static_cast<quint64>(index % subBucketHalfCount + subBucketHalfCount);
+    return (subBucket << shift) + ((quint64{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) noexcept {
+    const auto value = static_cast<quint64>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+    mBuckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+    updateMin(mMin, value);
+    updateMax(mMax, value);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+quint64 LatencyHistogram::count() const noexcept {
+    return mCount.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds LatencyHistogram::min() const noexcept {
+    if (count() == 0) {
+        return {};
+    }
+    return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(mMin.load(std::memory_order_relaxed))};
+}
+
+std::chrono::nanoseconds LatencyHistogram::max() const noexcept {
+    return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(mMax.load(std::memory_order_relaxed))};
+}
+
+std::chrono::nanoseconds LatencyHistogram::mean() const noexcept {
+    const auto n = count();
+    if (n == 0) {
+        return {};
+    }
+    return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(mSum.load(std::memory_order_relaxed) / n)};
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double percentile) const noexcept {
+    const auto n = count();
+    if (n == 0) {
+        return {};
+    }
+
+    const auto rank = std::clamp(static_cast<quint64>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * n)),
+                                 quint64{1}, n);
+    quint64 seen = 0;
+    for (std::size_t i = 0; i < mBuckets.size(); ++i) {
+        seen += mBuckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(bucketUpperBound(i))}, max());
+        }
+    }
+    // Only reachable when values are being recorded concurrently
+    return max();
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto &bucket : mBuckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    mCount.store(0, std::memory_order_relaxed);
+    mSum.store(0, std::memory_order_relaxed);
+    mMin.store(std::numeric_limits<quint64>::max(), std::memory_order_relaxed);
+    mMax.store(0, std::memory_order_relaxed);
+}
+
+void HistogramTracer::suspended(const Tracing::SuspensionEvent &) noexcept {}
+
+void HistogramTracer::resumed(const Tracing::SuspensionEvent &event,
+                              std::chrono::steady_clock::time_point resumedAt) noexcept {
+    mHistograms[static_cast<std::size_t>(event.kind)].record(resumedAt - event.suspendedAt);
+}
+
+const LatencyHistogram &HistogramTracer::histogram(Tracing::SuspensionKind kind) const noexcept {
+    return mHistograms[static_cast<std::size_t>(kind)];
+}
+
+void HistogramTracer::reset() noexcept {
+    for (auto &histogram : mHistograms) {
+        histogram.reset();
+    }
+}
+
+void HistogramTracer::dump() const {
+    qInfo().noquote() << QStringLiteral("QCoro: suspension durations in microseconds");
+    qInfo().noquote() << QStringLiteral("%1 %2 %3 %4 %5 %6 %7 %8")
+                             .arg(QStringLiteral("kind"), -10)
+                             .arg(QStringLiteral("count"), 10)
+                             .arg(QStringLiteral("min"), 10)
+                             .arg(QStringLiteral("p50"), 10)
+                             .arg(QStringLiteral("p90"), 10)
+                             .arg(QStringLiteral("p99"), 10)
+                             .arg(QStringLiteral("p99.9"), 10)
+                             .arg(QStringLiteral("max"), 10);
+    for (int i = 0; i < Tracing::suspensionKindCount; ++i) {
+        const auto kind = static_cast<Tracing::SuspensionKind>(i);
+        const auto &histogram = this->histogram(kind);
+        if (histogram.count() == 0) {
+            continue;
+        }
+        qInfo().noquote() << QStringLiteral("%1 %2 %3 %4 %5 %6 %7 %8")
+                                 .arg(QString::fromLatin1(Tracing::suspensionKindName(kind)), -10)
+                                 .arg(histogram.count(), 10)
+                                 .arg(formatDuration(histogram.min()), 10)
+                                 .arg(formatDuration(histogram.percentile(50.0)), 10)
+                                 .arg(formatDuration(histogram.percentile(90.0)), 10)
+                                 .arg(formatDuration(histogram.percentile(99.0)), 10)
+                                 .arg(formatDuration(histogram.percentile(99.9)), 10)
+                                 .arg(formatDuration(histogram.max()), 10);
+    }
+}
+
+ChromeTraceTracer::ChromeTraceTracer(std::size_t maxEvents)
+    : d(std::make_unique<detail::ChromeTraceTracerPrivate>(maxEvents))
+{}
+
+ChromeTraceTracer::~ChromeTraceTracer() = default;
+
+void ChromeTraceTracer::suspended(const Tracing::SuspensionEvent &) noexcept {}
+
+void ChromeTraceTracer::resumed(const Tracing::SuspensionEvent &event,
+                                std::chrono::steady_clock::time_point resumedAt) noexcept {
+    const auto resumedThread = QThread::currentThreadId();
+    QMutexLocker locker(&d->mutex);
+    if (d->spans.size() >= d->maxEvents) {
+        ++d->dropped;
+        return;
+    }
+    d->spans.push_back({event.kind, event.coroutine, event.thread, resumedThread, event.suspendedAt, resumedAt});
+}
+
+std::size_t ChromeTraceTracer::eventCount() const {
+    QMutexLocker locker(&d->mutex);
+    return d->spans.size();
+}
+
+std::size_t ChromeTraceTracer::droppedEventCount() const {
+    QMutexLocker locker(&d->mutex);
+    return d->dropped;
+}
+
+void ChromeTraceTracer::clear() {
+    QMutexLocker locker(&d->mutex);
+    d->spans.clear();
+    d->dropped = 0;
+}
+
+bool ChromeTraceTracer::save(const QString &fileName) const {
+    const auto pid = QByteArray::number(QCoreApplication::applicationPid());
+    const auto micros = [this](std::chrono::steady_clock::time_point time) {
+        return QByteArray::number(std::chrono::duration<double, std::micro>(time - d->start).count(), 'f', 3);
+    };
+
+    QByteArray json;
+    {
+        QMutexLocker locker(&d->mutex);
+        // Thread handles are pointers, map them to small numbers that survive the JSON round-trip.
+        QHash<Qt::HANDLE, int> threadIds;
+        const auto threadId = [&threadIds](Qt::HANDLE thread) {
+            auto it = threadIds.find(thread);
+            if (it == threadIds.end()) {
+                it = threadIds.insert(thread, static_cast<int>(threadIds.size()) + 1);
+            }
+            return QByteArray::number(*it);
+        };
+
+        json.reserve(static_cast<qsizetype>(d->spans.size()) * 160);
+        json += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (const auto &span : d->spans) {
+            if (!first) {
+                json += ",\n";
+            }
+            first = false;
+            json += "{\"name\":\"";
+            json += Tracing::suspensionKindName(span.kind);
+            json += "\",\"cat\":\"qcoro\",\"ph\":\"X\",\"pid\":" + pid;
+            json += ",\"tid\":" + threadId(span.suspendedThread);
+            json += ",\"ts\":" + micros(span.suspendedAt);
+            json += ",\"dur\":" + QByteArray::number(std::chrono::duration<double, std::micro>(span.resumedAt - span.suspendedAt).count(), 'f', 3);
+            json += ",\"args\":{\"coroutine\":\"0x" + QByteArray::number(reinterpret_cast<quintptr>(span.coroutine), 16);
+            json += "\",\"resumedOnThread\":" + threadId(span.resumedThread) + "}}";
+        }
+        for (auto it = threadIds.cbegin(); it != threadIds.cend(); ++it) {
+            if (!first) {
+                json += ",\n";
+            }
+            first = false;
+            const auto tid = QByteArray::number(it.value());
+            json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid
+                    + ",\"args\":{\"name\":\"Thread " + tid + "\"}}";
+        }
+        json += "]}\n";
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "QCoro::ChromeTraceTracer: Failed to open" << fileName << "for writing:" << file.errorString();
+        return false;
+    }
+    return file.write(json) == json.size();
+}
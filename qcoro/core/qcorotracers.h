@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorotracing.h"
+#include "qcorocore_export.h"
+
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+namespace QCoro {
+
+namespace detail {
+struct ChromeTraceTracerPrivate;
+} // namespace detail
+
+//! Histogram of durations with a bounded relative error, in the style of HdrHistogram.
+/*!
+ * The durations are recorded with nanosecond resolution into buckets whose width grows with
+ * the magnitude of the recorded value, so that any percentile is reported with a relative
+ * error of at most 1/32 (about 3%), from nanoseconds up to hundreds of years.
+ *
+ * Recording is lock-free and can be done from multiple threads at the same time.
+ */
+class QCOROCORE_EXPORT LatencyHistogram {
+public:
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    //! Records a single duration. Negative durations are recorded as zero.
+    void record(std::chrono::nanoseconds duration) noexcept;
+
+    //! Returns the number of recorded durations.
+    quint64 count() const noexcept;
+    //! Returns the shortest recorded duration.
+    std::chrono::nanoseconds min() const noexcept;
+    //! Returns the longest recorded duration.
+    std::chrono::nanoseconds max() const noexcept;
+    //! Returns the mean of the recorded durations.
+    std::chrono::nanoseconds mean() const noexcept;
+    //! Returns the duration below which \c percentile percent of the recorded durations are.
+    /*!
+     * The \c percentile is in the range [0, 100]. The returned value is the upper bound of
+     * the bucket the percentile falls into, so it's never lower than the actual value.
+     */
+    std::chrono::nanoseconds percentile(double percentile) const noexcept;
+
+    //! Discards all recorded durations.
+    void reset() noexcept;
+
+private:
+    static constexpr int subBucketBits = 6;
+    static constexpr int subBucketCount = 1 << subBucketBits;
+    static constexpr int subBucketHalfCount = subBucketCount / 2;
+    static constexpr int bucketCount = (64 - subBucketBits) * subBucketHalfCount + subBucketCount;
+
+    static std::size_t bucketIndex(quint64 value) noexcept;
+    static quint64 bucketUpperBound(std::size_t index) noexcept;
+
+    std::array<std::atomic<quint64>, bucketCount> mBuckets{};
+    std::atomic<quint64> mCount{0};
+    std::atomic<quint64> mSum{0};
+    std::atomic<quint64> mMin{std::numeric_limits<quint64>::max()};
+    std::atomic<quint64> mMax{0};
+};
+
+//! Tracer that collects a histogram of suspension durations for each kind of suspension point.
+/*!
+ * ```cpp
+ * QCoro::HistogramTracer tracer;
+ * QCoro::Tracing::setTracer(&tracer);
+ * co_await runLoadTest();
+ * QCoro::Tracing::setTracer(nullptr);
+ * tracer.dump();
+ * ```
+ */
+class QCOROCORE_EXPORT HistogramTracer : public Tracer {
+public:
+    HistogramTracer() = default;
+
+    void suspended(const Tracing::SuspensionEvent &event) noexcept override;
+    void resumed(const Tracing::SuspensionEvent &event,
+                 std::chrono::steady_clock::time_point resumedAt) noexcept override;
+
+    //! Returns the histogram of suspension durations for the given \c kind of suspension point.
+    const LatencyHistogram &histogram(Tracing::SuspensionKind kind) const noexcept;
+
+    //! Discards all recorded durations.
+    void reset() noexcept;
+
+    //! Prints the count and percentiles of the suspension durations using qInfo().
+    void dump() const;
+
+private:
+    std::array<LatencyHistogram, Tracing::suspensionKindCount> mHistograms;
+};
+
+//! Tracer that records the suspensions as events in the Chrome trace event format.
+/*!
+ * Each suspension is recorded as a span from the moment the coroutine suspended until it
+ * resumed. The spans are kept in memory and written by save() to a JSON file that can be opened
+ * in Perfetto (https://ui.perfetto.dev) or in \c chrome://tracing.
+ */
+class QCOROCORE_EXPORT ChromeTraceTracer : public Tracer {
+public:
+    //! Constructs the tracer. At most \c maxEvents are recorded, further events are dropped.
+    explicit ChromeTraceTracer(std::size_t maxEvents = 1'000'000);
+    ~ChromeTraceTracer() override;
+
+    void suspended(const Tracing::SuspensionEvent &event) noexcept override;
+    void resumed(const Tracing::SuspensionEvent &event,
+                 std::chrono::steady_clock::time_point resumedAt) noexcept override;
+
+    //! Returns the number of recorded events.
+    std::size_t eventCount() const;
+    //! Returns the number of events that have been dropped because the limit was reached.
+    std::size_t droppedEventCount() const;
+
+    //! Discards all recorded events.
+    void clear();
+
+    //! Writes the recorded events into the file \c fileName, returns whether it succeeded.
+    bool save(const QString &fileName) const;
+
+private:
+    std::unique_ptr<detail::ChromeTraceTracerPrivate> d;
+};
+
+} // namespace QCoro
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+ * Do NOT include this file directly - include the QCoroTask header instead!
+ */
+
+#pragma once
+
+#include "../coroutine.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace QCoro::detail
+{
+
+//! Returns the Awaiter for the given Awaitable.
+template<typename T>
+decltype(auto) getAwaiter(T &&awaitable) {
+    if constexpr (has_member_operator_coawait<T>) {
+        return std::forward<T>(awaitable).operator co_await();
+    } else if constexpr (has_nonmember_operator_coawait<T>) {
+        return operator co_await(std::forward<T>(awaitable));
+    } else {
+        return std::forward<T>(awaitable);
+    }
+}
+
+//! Wraps an Awaitable to notify the \c Context of the awaiting coroutine when the coroutine suspends and resumes.
+/*!
+ * The \c Context must provide a \c resumed() method and a \c suspending() method that returns
+ * a scope which restores the outer context when destroyed.
+ *
+ * \c Awaitable is a reference type, unless the awaitable is a temporary object created by
+ * await_transform(), in which case it's stored in the wrapper.
+ */
+template<typename Context, typename Awaitable>
+class ContextAwaiter {
+    using Awaiter = decltype(getAwaiter(std::declval<Awaitable>()));
+
+public:
+    //! Constructs the wrapped awaitable in-place from the result of \c factory, so it's never moved.
+    template<typename Factory>
+    ContextAwaiter(Context &context, Factory &&factory)
+        : mContext(context)
+        , mAwaitable(factory())
+        , mAwaiter(getAwaiter(static_cast<Awaitable &&>(mAwaitable))) {}
+
+    ContextAwaiter(const ContextAwaiter &) = delete;
+    ContextAwaiter &operator=(const ContextAwaiter &) = delete;
+
+    bool await_ready() {
+        return mAwaiter.await_ready();
+    }
+
+    template<typename Promise>
+    auto await_suspend(std::coroutine_handle<Promise> awaitingCoroutine) {
+        mSuspended = true;
+        // The outer context is only restored once await_suspend() returns, so that whatever the
+        // awaiter does to suspend the coroutine (connecting signals, starting timers...) still
+        // happens in the context of this coroutine. The coroutine may already be resumed (and
+        // even finished) by the time this returns, so don't touch any members afterwards.
+        const auto scope = mContext.suspending();
+        return mAwaiter.await_suspend(awaitingCoroutine);
+    }
+
+    decltype(auto) await_resume() {
+        if (mSuspended) {
+            mContext.resumed();
+        }
+        return mAwaiter.await_resume();
+    }
+
+private:
+    Context &mContext;
+    Awaitable mAwaitable;
+    Awaiter mAwaiter;
+    bool mSuspended = false;
+};
+
+} // namespace QCoro::detail
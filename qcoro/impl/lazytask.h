@@ -21,8 +21,8 @@ inline LazyTask<T> LazyTaskPromise<T>::get_return_object() noexcept {
 }
 
 template<typename T>
-inline std::suspend_always LazyTaskPromise<T>::initial_suspend() const noexcept {
-    return {};
+inline TaskInitialSuspend LazyTaskPromise<T>::initial_suspend() noexcept {
+    return TaskInitialSuspend{*this, true};
 }
 
 } // namespace detail
@@ -52,6 +52,7 @@ inline auto LazyTask<T>::operator co_await() const noexcept {
 
         auto await_resume() {
             Q_ASSERT(this->mAwaitedCoroutine);
+            this->mTrace.resumed();
             if constexpr (!std::is_void_v<T>) {
                 return std::move(this->mAwaitedCoroutine.promise().result());
             } else {
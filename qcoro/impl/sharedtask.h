@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorosharedtask.h"
+#include "qcorotask.h"
+
+#include <utility>
+
+namespace QCoro {
+
+namespace detail {
+
+template<typename T>
+inline SharedTask<T> SharedTaskPromise<T>::get_return_object() noexcept {
+    return SharedTask<T>(std::coroutine_handle<SharedTaskPromise>::from_promise(*this));
+}
+
+} // namespace detail
+
+template<typename T>
+inline SharedTask<T>::SharedTask(const SharedTask &other) noexcept
+    : detail::TaskBase<T, SharedTask, promise_type>() {
+    this->mCoroutine = other.mCoroutine;
+    if (this->mCoroutine) {
+        this->mCoroutine.promise().refCoroutine();
+    }
+}
+
+template<typename T>
+inline auto SharedTask<T>::operator=(const SharedTask &other) noexcept -> SharedTask & {
+    if (std::addressof(other) != this) {
+        if (other.mCoroutine) {
+            other.mCoroutine.promise().refCoroutine();
+        }
+        if (this->mCoroutine) {
+            this->mCoroutine.promise().derefCoroutine();
+        }
+        this->mCoroutine = other.mCoroutine;
+    }
+    return *this;
+}
+
+template<typename T>
+inline auto SharedTask<T>::operator co_await() const & noexcept {
+    return awaiter<detail::SharedTaskResult<T>>();
+}
+
+template<typename T>
+inline auto SharedTask<T>::operator co_await() const && noexcept {
+    return awaiter<T>();
+}
+
+template<typename T>
+template<typename Result>
+inline auto SharedTask<T>::awaiter() const noexcept {
+    //! Specialization of the TaskAwaiterBase that returns the promise result without consuming it
+    class TaskAwaiter : public detail::TaskAwaiterBase<promise_type> {
+    public:
+        TaskAwaiter(std::coroutine_handle<promise_type> awaitedCoroutine)
+            : detail::TaskAwaiterBase<promise_type>{awaitedCoroutine} {}
+
+        Result await_resume() {
+            Q_ASSERT(this->mAwaitedCoroutine);
+            this->mTrace.resumed();
+            if constexpr (!std::is_void_v<T>) {
+                return std::as_const(this->mAwaitedCoroutine.promise().result());
+            } else {
+                // Wil re-throw exception, if any is stored
+                this->mAwaitedCoroutine.promise().result();
+            }
+        }
+    };
+
+    return TaskAwaiter{this->mCoroutine};
+}
+
+template<typename Awaitable>
+requires detail::TaskConvertible<Awaitable>
+inline auto toSharedTask(Awaitable awaitable) -> SharedTask<detail::convertible_awaitable_return_type_t<Awaitable>> {
+    co_return co_await std::move(awaitable);
+}
+
+} // namespace QCoro
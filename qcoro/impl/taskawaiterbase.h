@@ -26,6 +26,8 @@ inline void TaskAwaiterBase<Promise>::await_suspend(std::coroutine_handle<> awai
         return;
     }
 
+    // Must be called before the awaited coroutine can resume us
+    mTrace.suspended(Tracing::SuspensionKind::Task, awaitingCoroutine);
     mAwaitedCoroutine.promise().addAwaitingCoroutine(awaitingCoroutine);
 }
 
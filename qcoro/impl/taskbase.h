@@ -18,6 +18,9 @@ namespace QCoro::detail {
 template<typename T, template<typename> class TaskImpl, typename PromiseType>
 inline TaskBase<T, TaskImpl, PromiseType>::TaskBase(std::coroutine_handle<PromiseType> coroutine) : mCoroutine(coroutine) {
     mCoroutine.promise().refCoroutine();
+#ifdef QCORO_COROUTINE_REGISTRY
+    mCoroutine.promise().setFrame(mCoroutine.address());
+#endif
 }
 
 template<typename T, template<typename> class TaskImpl, typename PromiseType>
@@ -65,6 +68,7 @@ inline auto TaskBase<T, TaskImpl, PromiseType>::operator co_await() const noexce
          * value co_returned by the coroutine. */
         auto await_resume() {
             Q_ASSERT(this->mAwaitedCoroutine);
+            this->mTrace.resumed();
             if constexpr (!std::is_void_v<T>) {
                 return std::move(this->mAwaitedCoroutine.promise().result());
             } else {
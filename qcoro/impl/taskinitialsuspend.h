@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+ * Do NOT include this file directly - include the QCoroTask header instead!
+ */
+
+#pragma once
+
+#include "../qcorotask.h"
+
+namespace QCoro::detail
+{
+
+inline TaskInitialSuspend::TaskInitialSuspend(TaskPromiseBase &promise, bool suspend)
+    : mPromise(promise), mSuspend(suspend) {}
+
+inline bool TaskInitialSuspend::await_ready() const noexcept {
+    return !mSuspend;
+}
+
+constexpr void TaskInitialSuspend::await_suspend(std::coroutine_handle<>) const noexcept {}
+
+inline void TaskInitialSuspend::await_resume() const noexcept {
+    mPromise.resumed();
+}
+
+} // namespace QCoro::detail
@@ -9,26 +9,119 @@
 #pragma once
 
 #include "../qcorotask.h"
+#include "contextawaiter.h"
 #include <coroutine>
 
 namespace QCoro::detail
 {
 
-inline TaskPromiseBase::TaskPromiseBase()
+inline TaskPromiseBase::TaskPromiseBase([[maybe_unused]] registry::Location location)
     : mRefCount(1)
+#ifdef QCORO_COROUTINE_REGISTRY
+    , mRegistryEntry(location)
+#endif
 {
 }
 
-inline std::suspend_never TaskPromiseBase::initial_suspend() const noexcept {
-    return {};
+inline TaskInitialSuspend TaskPromiseBase::initial_suspend() noexcept {
+    return TaskInitialSuspend{*this, false};
 }
 
 inline auto TaskPromiseBase::final_suspend() const noexcept {
+    // Restore the context of whoever resumed us before we resume the awaiting coroutines
+    suspended();
+#ifdef QCORO_COROUTINE_REGISTRY
+    mRegistryEntry.finished();
+#endif
     return TaskFinalSuspend{mAwaitingCoroutines};
 }
 
+template<typename T>
+requires requires(AwaitTransformMixin &mixin, T &&value) { mixin.await_transform(std::forward<T>(value)); }
+inline auto TaskPromiseBase::await_transform(T &&value, [[maybe_unused]] registry::Location location) {
+    using Awaitable = decltype(std::declval<AwaitTransformMixin &>().await_transform(std::forward<T>(value)));
+#ifdef QCORO_INSTRUMENTATION
+    mInstrumentationContext.awaited();
+#endif
+#ifdef QCORO_COROUTINE_REGISTRY
+    mRegistryEntry.awaiting<std::remove_cvref_t<T>>(value, location);
+#endif
+    // Only switches the thread_local context when the coroutine actually suspends, the cost is
+    // documented in docs/reference/coro/deadline.md.
+    return ContextAwaiter<TaskPromiseBase, Awaitable>{*this, [this, &value]() -> Awaitable {
+        return AwaitTransformMixin::await_transform(std::forward<T>(value));
+    }};
+}
+
+inline std::suspend_never TaskPromiseBase::await_transform(DeadlineRequest request) noexcept {
+    mDeadlineContext.tighten(request.deadline);
+    return {};
+}
+
+inline void TaskPromiseBase::resumed() noexcept {
+    mDeadlineContext.resumed();
+#ifdef QCORO_INSTRUMENTATION
+    mInstrumentationContext.resumed();
+#endif
+#ifdef QCORO_COROUTINE_REGISTRY
+    mRegistryEntry.resumed();
+#endif
+}
+
+inline void TaskPromiseBase::suspended() const noexcept {
+    mDeadlineContext.suspended();
+#ifdef QCORO_INSTRUMENTATION
+    mInstrumentationContext.suspended();
+#endif
+#ifdef QCORO_COROUTINE_REGISTRY
+    mRegistryEntry.suspended();
+#endif
+}
+
+inline TaskPromiseBase::SuspendScope::SuspendScope(const TaskPromiseBase &promise) noexcept
+    : mOuterDeadline(promise.mDeadlineContext.outerDeadline())
+#ifdef QCORO_INSTRUMENTATION
+    , mOuterRecord(promise.mInstrumentationContext.outerRecord())
+#endif
+{
+}
+
+inline TaskPromiseBase::SuspendScope::~SuspendScope() {
+    threadDeadline() = mOuterDeadline;
+#ifdef QCORO_INSTRUMENTATION
+    instrumentation::currentCoroutine() = mOuterRecord;
+#endif
+}
+
+inline TaskPromiseBase::SuspendScope TaskPromiseBase::suspending() const noexcept {
+#ifdef QCORO_COROUTINE_REGISTRY
+    mRegistryEntry.suspended();
+#endif
+    return SuspendScope{*this};
+}
+
+#ifdef QCORO_COROUTINE_REGISTRY
+inline void TaskPromiseBase::setFrame(const void *frame) noexcept {
+    mRegistryEntry.setFrame(frame);
+}
+#endif
+
+#ifdef QCORO_INSTRUMENTATION
+// Must not be inlined, so that the return address points into the coroutine function
+Q_NEVER_INLINE inline void *TaskPromiseBase::operator new(std::size_t size) {
+    return instrumentation::allocateFrame(size, QCORO_RETURN_ADDRESS());
+}
+
+inline void TaskPromiseBase::operator delete(void *ptr) noexcept {
+    instrumentation::deallocateFrame(ptr);
+}
+#endif
+
 inline void TaskPromiseBase::addAwaitingCoroutine(std::coroutine_handle<> awaitingCoroutine) {
     mAwaitingCoroutines.push_back(awaitingCoroutine);
+#ifdef QCORO_COROUTINE_REGISTRY
+    mRegistryEntry.setAwaitingFrame(awaitingCoroutine.address());
+#endif
 }
 
 inline bool TaskPromiseBase::hasAwaitingCoroutine() const {
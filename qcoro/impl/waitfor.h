@@ -11,6 +11,11 @@
 #include "../qcorotask.h"
 
 #include <QEventLoop>
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
 
 #include <optional>
 
@@ -27,7 +32,49 @@ auto toTask(Awaitable &&future) -> QCoro::Task<detail::convertible_awaitable_ret
 }
 
 struct WaitContext {
-    QEventLoop loop;
+    explicit WaitContext(WaitMode mode) {
+        if (mode == WaitMode::EventLoop) {
+            loop.emplace();
+        }
+    }
+
+    //! Called from the coroutine (possibly in a different thread) when it finishes.
+    void finish() {
+        // Everything is done while holding the lock, otherwise the waiting thread could
+        // see the flag and destroy the context before we are done with it.
+        QMutexLocker locker(&mutex);
+        coroutineFinished = true;
+        if (!loop) {
+            condition.wakeOne();
+        } else if (loop->thread() == QThread::currentThread()) {
+            loop->quit();
+        } else {
+            // Calling quit() before the other thread enters exec() would have no effect,
+            // the queued call is only processed once the loop is running.
+            QMetaObject::invokeMethod(&*loop, &QEventLoop::quit, Qt::QueuedConnection);
+        }
+    }
+
+    //! Waits in the calling thread until finish() is called.
+    void wait() {
+        QMutexLocker locker(&mutex);
+        if (loop) {
+            if (!coroutineFinished) {
+                locker.unlock();
+                loop->exec();
+                // Wait for finish() to release the lock
+                locker.relock();
+            }
+        } else {
+            while (!coroutineFinished) {
+                condition.wait(&mutex);
+            }
+        }
+    }
+
+    std::optional<QEventLoop> loop;
+    QMutex mutex;
+    QWaitCondition condition;
     bool coroutineFinished = false;
     std::exception_ptr exception;
 };
@@ -48,8 +95,7 @@ Task<> runCoroutine(WaitContext &context, Awaitable &&awaitable) {
     } catch (...) {
         context.exception = std::current_exception();
     }
-    context.coroutineFinished = true;
-    context.loop.quit();
+    context.finish();
 }
 
 template<typename T, Awaitable Awaitable>
@@ -59,27 +105,22 @@ Task<> runCoroutine(WaitContext &context, std::optional<T> &result, Awaitable &&
     } catch (...) {
         context.exception = std::current_exception();
     }
-    context.coroutineFinished = true;
-    context.loop.quit();
+    context.finish();
 }
 
 template<typename T, Awaitable Awaitable>
-T waitFor(Awaitable &&awaitable) {
-    WaitContext context;
+T waitFor(Awaitable &&awaitable, WaitMode mode) {
+    WaitContext context(mode);
     if constexpr (std::is_void_v<T>) {
         runCoroutine(context, std::forward<Awaitable>(awaitable));
-        if (!context.coroutineFinished) {
-            context.loop.exec();
-        }
+        context.wait();
         if (context.exception) {
             std::rethrow_exception(context.exception);
         }
     } else {
         std::optional<T> result;
         runCoroutine(context, result, std::forward<Awaitable>(awaitable));
-        if (!context.coroutineFinished) {
-            context.loop.exec();
-        }
+        context.wait();
         if (context.exception) {
             std::rethrow_exception(context.exception);
         }
@@ -90,18 +131,18 @@ T waitFor(Awaitable &&awaitable) {
 } // namespace detail
 
 template<typename T>
-inline T waitFor(QCoro::Task<T> &task) {
-    return detail::waitFor<T>(std::forward<QCoro::Task<T>>(task));
+inline T waitFor(QCoro::Task<T> &task, WaitMode mode) {
+    return detail::waitFor<T>(std::forward<QCoro::Task<T>>(task), mode);
 }
 
 template<typename T>
-inline T waitFor(QCoro::Task<T> &&task) {
-    return detail::waitFor<T>(std::forward<QCoro::Task<T>>(task));
+inline T waitFor(QCoro::Task<T> &&task, WaitMode mode) {
+    return detail::waitFor<T>(std::forward<QCoro::Task<T>>(task), mode);
 }
 
 template<Awaitable Awaitable>
-inline auto waitFor(Awaitable &&awaitable) {
-    return detail::waitFor<detail::awaitable_return_type_t<Awaitable>>(std::forward<Awaitable>(awaitable));
+inline auto waitFor(Awaitable &&awaitable, WaitMode mode) {
+    return detail::waitFor<detail::awaitable_return_type_t<Awaitable>>(std::forward<Awaitable>(awaitable), mode);
 }
 
 } // namespace QCoro
\ No newline at end of file
@@ -9,3 +9,11 @@
     Class(Class &&) noexcept = default;                                                            \
     Class &operator=(Class &&) noexcept = default;
 #endif
+
+#ifndef QCORO_NO_UNIQUE_ADDRESS
+#if defined(_MSC_VER) && !defined(__clang__)
+#define QCORO_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define QCORO_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+#endif
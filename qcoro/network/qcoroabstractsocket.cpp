@@ -4,8 +4,11 @@
 
 #include "qcoroabstractsocket.h"
 #include "qcoroiodevice_p.h"
+#include "qcoropromise.h"
 #include "qcorosignal.h"
 
+#include <QTimer>
+
 using namespace QCoro::detail;
 using namespace std::chrono_literals;
 
@@ -106,4 +109,57 @@ QCoro::Task<bool> QCoroAbstractSocket::connectToHost(const QHostAddress &address
     return waitForConnected(timeout);
 }
 
+QCoro::Task<QCoro::Expected<void, QAbstractSocket::SocketError>> QCoroAbstractSocket::tryWaitForConnected(
+        std::chrono::milliseconds timeout) {
+    using Result = Expected<void, QAbstractSocket::SocketError>;
+
+    const QPointer<QAbstractSocket> socket = static_cast<QAbstractSocket *>(mDevice.data());
+    if (socket->state() == QAbstractSocket::ConnectedState) {
+        co_return Result{};
+    }
+    if (socket->state() == QAbstractSocket::UnconnectedState) {
+        // The connection has failed synchronously, or has never been started
+        co_return Unexpected(socket->error());
+    }
+
+    // Whichever comes first resolves the promise, the rest is ignored. The connections are queued,
+    // so that the coroutine is never resumed from within a signal emission of the socket or the timer
+    // and can safely delete them.
+    Promise<Result> promise;
+    QObject context;
+    QObject::connect(socket, &QAbstractSocket::connected, &context,
+                     [promise]() { promise.setValue(Result{}); }, Qt::QueuedConnection);
+    QObject::connect(socket, &QAbstractSocket::errorOccurred, &context,
+                     [promise](QAbstractSocket::SocketError error) { promise.setValue(Unexpected(error)); },
+                     Qt::QueuedConnection);
+    QObject::connect(socket, &QObject::destroyed, &context,
+                     [promise]() { promise.setValue(Unexpected(QAbstractSocket::UnknownSocketError)); },
+                     Qt::QueuedConnection);
+
+    QTimer timer;
+    timeout = timeoutWithDeadline(timeout);
+    if (timeout.count() > -1) {
+        timer.setSingleShot(true);
+        QObject::connect(&timer, &QTimer::timeout, &context,
+                         [promise]() { promise.setValue(Unexpected(QAbstractSocket::SocketTimeoutError)); },
+                         Qt::QueuedConnection);
+        timer.start(timeout);
+    }
+
+    co_return co_await promise.task();
+}
+
+QCoro::Task<QCoro::Expected<void, QAbstractSocket::SocketError>> QCoroAbstractSocket::tryConnectToHost(
+        const QString &hostName, quint16 port, QIODevice::OpenMode openMode,
+        QAbstractSocket::NetworkLayerProtocol protocol, std::chrono::milliseconds timeout) {
+    static_cast<QAbstractSocket *>(mDevice.data())->connectToHost(hostName, port, openMode, protocol);
+    return tryWaitForConnected(timeout);
+}
+
+QCoro::Task<QCoro::Expected<void, QAbstractSocket::SocketError>> QCoroAbstractSocket::tryConnectToHost(
+        const QHostAddress &address, quint16 port, QIODevice::OpenMode openMode, std::chrono::milliseconds timeout) {
+    static_cast<QAbstractSocket *>(mDevice.data())->connectToHost(address, port, openMode);
+    return tryWaitForConnected(timeout);
+}
+
 #include "qcoroabstractsocket.moc"
\ No newline at end of file
@@ -104,6 +104,34 @@ public:
                              QIODevice::OpenMode openMode = QIODevice::ReadWrite,
                              std::chrono::milliseconds timeout = std::chrono::seconds{30});
 
+    //! Like waitForConnected(), but reports why the connection has failed.
+    /*!
+     * Returns an empty result once the socket is connected. If the connection fails, returns
+     * the error reported by the socket as soon as it occurs, rather than waiting for the timeout.
+     * If the operation times out, returns `QAbstractSocket::SocketTimeoutError`.
+     */
+    Task<Expected<void, QAbstractSocket::SocketError>> tryWaitForConnected(
+        std::chrono::milliseconds timeout = std::chrono::seconds{30});
+
+    //! Like connectToHost(), but reports why the connection has failed.
+    /*!
+     * See tryWaitForConnected() for details.
+     */
+    Task<Expected<void, QAbstractSocket::SocketError>> tryConnectToHost(
+        const QString &hostName, quint16 port,
+        QIODevice::OpenMode openMode = QIODevice::ReadWrite,
+        QAbstractSocket::NetworkLayerProtocol protocol = QAbstractSocket::AnyIPProtocol,
+        std::chrono::milliseconds timeout = std::chrono::seconds{30});
+
+    //! Like connectToHost(), but reports why the connection has failed.
+    /*!
+     * See tryWaitForConnected() for details.
+     */
+    Task<Expected<void, QAbstractSocket::SocketError>> tryConnectToHost(
+        const QHostAddress &address, quint16 port,
+        QIODevice::OpenMode openMode = QIODevice::ReadWrite,
+        std::chrono::milliseconds timeout = std::chrono::seconds{30});
+
 private:
     Task<std::optional<bool>> waitForReadyReadImpl(std::chrono::milliseconds timeout) override;
     Task<std::optional<qint64>> waitForBytesWrittenImpl(std::chrono::milliseconds timeout) override;
@@ -15,7 +15,7 @@ using namespace std::chrono_literals;
 
 namespace {
 
-class SocketConnectedHelper : public QObject {
+class SocketConnectedHelper : public QObject, public QCoro::detail::tracing::IOSignalSource {
     Q_OBJECT
 public:
     SocketConnectedHelper(const QLocalSocket *socket, void(QLocalSocket::*signal)())
@@ -108,4 +108,17 @@ QCoro::Task<bool> QCoroNetworkReply::waitForFinished(std::chrono::milliseconds t
     co_return result.has_value();
 }
 
+QCoro::Task<QCoro::Expected<void, QNetworkReply::NetworkError>> QCoroNetworkReply::tryWaitForFinished(
+        std::chrono::milliseconds timeout) {
+    const auto *reply = static_cast<QNetworkReply *>(mDevice.data());
+    const bool finished = co_await waitForFinished(timeout);
+    if (!finished) {
+        co_return Unexpected(QNetworkReply::TimeoutError);
+    }
+    if (reply->error() != QNetworkReply::NoError) {
+        co_return Unexpected(reply->error());
+    }
+    co_return Expected<void, QNetworkReply::NetworkError>{};
+}
+
 #include "qcoronetworkreply.moc"
\ No newline at end of file
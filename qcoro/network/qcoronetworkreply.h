@@ -51,6 +51,16 @@ public:
      */
     Task<bool> waitForFinished(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
 
+    /**
+     * \brief Like waitForFinished(), but reports whether the reply has failed.
+     *
+     * Returns an empty result if the reply has finished successfully, otherwise returns the error
+     * of the reply. If the wait times out, returns `QNetworkReply::TimeoutError`; the reply is not
+     * aborted in that case.
+     */
+    Task<Expected<void, QNetworkReply::NetworkError>> tryWaitForFinished(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
 private:
     Task<std::optional<bool>> waitForReadyReadImpl(std::chrono::milliseconds timeout) override;
     Task<std::optional<qint64>> waitForBytesWrittenImpl(std::chrono::milliseconds timeout) override;
@@ -17,12 +17,14 @@ bool QCoroTcpServer::WaitForNewConnectionOperation::await_ready() const noexcept
 }
 
 void QCoroTcpServer::WaitForNewConnectionOperation::await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+    mTrace.suspended(QCoro::Tracing::SuspensionKind::IODevice, awaitingCoroutine);
     mConn = QObject::connect(mObj, &QTcpServer::newConnection,
                              std::bind(&WaitForNewConnectionOperation::resume, this, awaitingCoroutine));
     startTimeoutTimer(awaitingCoroutine);
 }
 
 QTcpSocket *QCoroTcpServer::WaitForNewConnectionOperation::await_resume() {
+    mTrace.resumed();
     return mTimedOut ? nullptr : mObj->nextPendingConnection();
 }
 
@@ -49,3 +51,20 @@ QCoro::Task<QTcpSocket *> QCoroTcpServer::waitForNewConnection(std::chrono::mill
     }
     co_return nullptr;
 }
+
+QCoro::Task<QCoro::Expected<QTcpSocket *, QAbstractSocket::SocketError>> QCoroTcpServer::tryWaitForNewConnection(
+        std::chrono::milliseconds timeout) {
+    const auto server = mServer;
+    if (!server->isListening()) {
+        co_return Unexpected(server->serverError());
+    }
+    if (server->hasPendingConnections()) {
+        co_return server->nextPendingConnection();
+    }
+
+    const auto result = co_await qCoro(server.data(), &QTcpServer::newConnection, timeout);
+    if (!result.has_value()) {
+        co_return Unexpected(QAbstractSocket::SocketTimeoutError);
+    }
+    co_return server->nextPendingConnection();
+}
@@ -5,9 +5,11 @@
 #pragma once
 
 #include "qcorotask.h"
+#include "qcoroexpected.h"
 #include "waitoperationbase_p.h"
 #include "qcoronetwork_export.h"
 
+#include <QAbstractSocket>
 #include <QPointer>
 
 #include <chrono>
@@ -58,6 +60,14 @@ public:
      */
     Task<QTcpSocket *> waitForNewConnection(std::chrono::milliseconds timeout);
 
+    //! Like waitForNewConnection(), but reports why there's no new connection.
+    /*!
+     * Returns the \c QTcpSocket of the pending connection. If the server is not listening, returns
+     * the last error of the server, and `QAbstractSocket::SocketTimeoutError` if the call times out.
+     */
+    Task<Expected<QTcpSocket *, QAbstractSocket::SocketError>> tryWaitForNewConnection(
+        std::chrono::milliseconds timeout = std::chrono::seconds{30});
+
 private:
     QPointer<QTcpServer> mServer;
 };
@@ -0,0 +1,913 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcoroasyncgenerator.h"
+#include "qcorotask.h"
+
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+#include <QRunnable>
+#include <QScopeGuard>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace QCoro {
+
+template<typename T, typename Stage>
+class AsyncGeneratorPipeline;
+
+//! Order in which QCoro::parallelMap() produces the results.
+enum class ResultOrder {
+    InputOrder,     //!< Results are produced in the order of the values they were computed from.
+    CompletionOrder //!< Results are produced as soon as they are computed.
+};
+
+/*! \cond internal */
+
+namespace detail {
+
+//! Type of values stored by adaptors that need to keep generated values around.
+template<typename T>
+using async_generator_value_t = std::remove_cvref_t<T>;
+
+//! Converts the value into a value that can be stored by an adaptor.
+/*!
+ * The value may reference a value living in the generator coroutine frame and the generator
+ * may still use it after it's resumed, so we only move from lvalues when the type cannot be
+ * copied at all.
+ */
+template<typename In>
+auto forwardValue(In &&value) -> std::remove_cvref_t<In> {
+    using Out = std::remove_cvref_t<In>;
+    if constexpr (std::is_lvalue_reference_v<In> && !std::is_copy_constructible_v<Out>) {
+        return std::move(value);
+    } else {
+        return std::forward<In>(value);
+    }
+}
+
+//! Obtains a storable value from the current position of the \c iterator.
+template<typename T>
+auto takeValue(QCoro::AsyncGeneratorIterator<T> &iterator) -> async_generator_value_t<T> {
+    return forwardValue(*iterator);
+}
+
+//! Fusable pipeline stage that transforms each value using a function.
+template<typename Fn>
+class MapStage {
+public:
+    explicit MapStage(Fn fn)
+        : mFn(std::move(fn)) {}
+
+    template<typename In>
+    auto operator()(In &&value, [[maybe_unused]] bool &finished) {
+        using Out = std::remove_cvref_t<std::invoke_result_t<Fn &, In>>;
+        return std::optional<Out>{std::invoke(mFn, std::forward<In>(value))};
+    }
+
+    constexpr bool isFinished() const noexcept {
+        return false;
+    }
+
+private:
+    Fn mFn;
+};
+
+//! Fusable pipeline stage that drops all values for which the predicate returns false.
+template<typename Predicate>
+class FilterStage {
+public:
+    explicit FilterStage(Predicate predicate)
+        : mPredicate(std::move(predicate)) {}
+
+    template<typename In>
+    auto operator()(In &&value, [[maybe_unused]] bool &finished) {
+        using Out = std::remove_cvref_t<In>;
+        if (!std::invoke(mPredicate, std::as_const(value))) {
+            return std::optional<Out>{};
+        }
+        return std::optional<Out>{forwardValue(std::forward<In>(value))};
+    }
+
+    constexpr bool isFinished() const noexcept {
+        return false;
+    }
+
+private:
+    Predicate mPredicate;
+};
+
+//! Fusable pipeline stage that finishes the pipeline after given number of values.
+class TakeStage {
+public:
+    explicit TakeStage(std::size_t count)
+        : mRemaining(count) {}
+
+    template<typename In>
+    auto operator()(In &&value, bool &finished) {
+        using Out = std::remove_cvref_t<In>;
+        Q_ASSERT(mRemaining > 0);
+        if (--mRemaining == 0) {
+            finished = true;
+        }
+        return std::optional<Out>{forwardValue(std::forward<In>(value))};
+    }
+
+    //! Returns true for take(0), so that the pipeline doesn't pull any value from the source.
+    bool isFinished() const noexcept {
+        return mRemaining == 0;
+    }
+
+private:
+    std::size_t mRemaining;
+};
+
+//! Two pipeline stages fused into one.
+template<typename First, typename Second>
+class ComposedStage {
+public:
+    ComposedStage(First first, Second second)
+        : mFirst(std::move(first)), mSecond(std::move(second)) {}
+
+    template<typename In>
+    auto operator()(In &&value, bool &finished) {
+        auto intermediate = mFirst(std::forward<In>(value), finished);
+        using Out = decltype(mSecond(std::move(*intermediate), finished));
+        if (!intermediate.has_value()) {
+            return Out{};
+        }
+        return mSecond(std::move(*intermediate), finished);
+    }
+
+    bool isFinished() const noexcept {
+        return mFirst.isFinished() || mSecond.isFinished();
+    }
+
+private:
+    First mFirst;
+    Second mSecond;
+};
+
+//! Operator object returned by the fusable adaptors (map(), filter(), take()).
+template<typename Stage>
+struct StageOperator {
+    Stage stage;
+};
+
+//! Tag base class for adaptors that wrap the source generator into a new generator.
+struct GeneratorOperator {};
+
+template<typename Op>
+concept generator_operator = std::is_base_of_v<GeneratorOperator, std::remove_cvref_t<Op>>;
+
+//! Runs the fused \c stage for each value produced by the \c source generator.
+template<typename Out, typename T, typename Stage>
+AsyncGenerator<Out> runPipeline(AsyncGenerator<T> source, Stage stage) {
+    // Don't pull any value from the source if the stage can't produce any
+    if (stage.isFinished()) {
+        co_return;
+    }
+
+    bool finished = false;
+    // Note: co_await in the for-loop increment expression trips GCC in templates
+    auto it = co_await source.begin();
+    while (it != source.end()) {
+        auto value = stage(*it, finished);
+        if (value.has_value()) {
+            co_yield std::move(*value);
+        }
+        if (finished) {
+            break;
+        }
+        co_await ++it;
+    }
+}
+
+//! Bounded buffer shared between a consumer generator and producer coroutines feeding it.
+/*!
+ * Adaptors that need to pull from their source generators while the consumer is busy
+ * (or while the consumer is waiting for something else, like a timer) run a producer
+ * coroutine for each source (see pumpInto()) that moves generated values into this
+ * buffer. All the coroutines involved must live in the same thread.
+ *
+ * Producers are suspended when the buffer is full and are resumed by the consumer as
+ * soon as it takes a value from the buffer. The consumer is resumed whenever a new
+ * value is pushed into the buffer or when a producer finishes.
+ */
+template<typename T>
+class AsyncGeneratorBuffer {
+public:
+    explicit AsyncGeneratorBuffer(std::size_t capacity)
+        : mCapacity(capacity) {}
+    Q_DISABLE_COPY(AsyncGeneratorBuffer)
+
+    //! Registers a new producer, must be called before the producer is started.
+    void addProducer() {
+        ++mProducers;
+    }
+
+    //! Called by a producer when its source generator is exhausted.
+    void producerFinished(std::exception_ptr exception = {}) {
+        --mProducers;
+        if (exception && !mException) {
+            mException = std::move(exception);
+        }
+        wakeConsumer();
+    }
+
+    void push(T &&value) {
+        mItems.push_back(std::move(value));
+        wakeConsumer();
+    }
+
+    //! Awaitable that suspends the producer until there's space in the buffer.
+    auto waitForSpace() noexcept {
+        struct Awaiter {
+            AsyncGeneratorBuffer &buffer;
+
+            bool await_ready() const noexcept {
+                return buffer.mClosed || buffer.mItems.size() < buffer.mCapacity;
+            }
+            void await_suspend(std::coroutine_handle<> producer) {
+                buffer.mBlockedProducers.push_back(producer);
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    //! Awaitable that suspends the consumer until anything changes in the buffer.
+    auto changed() noexcept {
+        struct Awaiter {
+            AsyncGeneratorBuffer &buffer;
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<> consumer) noexcept {
+                buffer.mConsumer = consumer;
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    //! Resumes the consumer if it's waiting for a change.
+    void wakeConsumer() {
+        if (mConsumer) {
+            std::exchange(mConsumer, nullptr).resume();
+        }
+    }
+
+    //! Takes the oldest value from the buffer and lets the blocked producers continue.
+    std::optional<T> pop() {
+        if (mItems.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> value{std::move(mItems.front())};
+        mItems.pop_front();
+        resumeProducers();
+        return value;
+    }
+
+    //! Takes all values from the buffer and lets the blocked producers continue.
+    std::vector<T> takeAll() {
+        std::vector<T> values;
+        values.reserve(mItems.size());
+        std::move(mItems.begin(), mItems.end(), std::back_inserter(values));
+        mItems.clear();
+        resumeProducers();
+        return values;
+    }
+
+    //! Called by the consumer when it's destroyed to let all producers terminate.
+    void close() {
+        mClosed = true;
+        mConsumer = nullptr;
+        resumeProducers();
+    }
+
+    void rethrowIfException() {
+        if (mException) {
+            std::rethrow_exception(std::exchange(mException, nullptr));
+        }
+    }
+
+    bool isClosed() const noexcept {
+        return mClosed;
+    }
+    bool isEmpty() const noexcept {
+        return mItems.empty();
+    }
+    bool isFull() const noexcept {
+        return mItems.size() >= mCapacity;
+    }
+    bool isFinished() const noexcept {
+        return mProducers == 0;
+    }
+    bool hasException() const noexcept {
+        return mException != nullptr;
+    }
+
+private:
+    void resumeProducers() {
+        // Resuming a producer may cause it to push another value and block again.
+        auto producers = std::exchange(mBlockedProducers, {});
+        for (auto producer : producers) {
+            producer.resume();
+        }
+    }
+
+    std::deque<T> mItems;
+    std::vector<std::coroutine_handle<>> mBlockedProducers;
+    std::coroutine_handle<> mConsumer;
+    std::exception_ptr mException;
+    std::size_t mCapacity;
+    std::size_t mProducers = 0;
+    bool mClosed = false;
+};
+
+//! Producer coroutine that moves values from \c source into the \c buffer.
+/*!
+ * The coroutine terminates when the source generator is exhausted, when the buffer is
+ * closed by the consumer or when another producer has failed. Note that if the consumer goes away while the source generator
+ * is suspended, the producer (and the source generator) will only be destroyed once the
+ * source generator is resumed.
+ */
+template<typename T>
+Task<> pumpInto(AsyncGenerator<T> source, std::shared_ptr<AsyncGeneratorBuffer<async_generator_value_t<T>>> buffer) {
+    std::exception_ptr exception;
+    try {
+        auto it = co_await source.begin();
+        while (it != source.end() && !buffer->isClosed() && !buffer->hasException()) {
+            buffer->push(takeValue(it));
+            co_await buffer->waitForSpace();
+            if (buffer->isClosed() || buffer->hasException()) {
+                break;
+            }
+            co_await ++it;
+        }
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    buffer->producerFinished(std::move(exception));
+}
+
+template<typename T>
+AsyncGenerator<std::vector<async_generator_value_t<T>>> chunkGenerator(AsyncGenerator<T> source, std::size_t size) {
+    using V = async_generator_value_t<T>;
+    std::vector<V> chunk;
+    chunk.reserve(size);
+    auto it = co_await source.begin();
+    while (it != source.end()) {
+        chunk.push_back(takeValue(it));
+        if (chunk.size() >= size) {
+            co_yield std::move(chunk);
+            chunk = std::vector<V>{};
+            chunk.reserve(size);
+        }
+        co_await ++it;
+    }
+    if (!chunk.empty()) {
+        co_yield std::move(chunk);
+    }
+}
+
+template<typename T>
+AsyncGenerator<std::vector<async_generator_value_t<T>>> windowGenerator(AsyncGenerator<T> source,
+                                                                        std::chrono::milliseconds duration,
+                                                                        std::size_t maxSize) {
+    using V = async_generator_value_t<T>;
+    auto buffer = std::make_shared<AsyncGeneratorBuffer<V>>(
+        maxSize > 0 ? maxSize : std::numeric_limits<std::size_t>::max());
+    const auto closeGuard = qScopeGuard([&buffer]() { buffer->close(); });
+
+    bool elapsed = false;
+    QTimer timer;
+    timer.setSingleShot(true);
+    QObject::connect(&timer, &QTimer::timeout, [&elapsed, buffer = buffer.get()]() {
+        elapsed = true;
+        buffer->wakeConsumer();
+    });
+
+    buffer->addProducer();
+    pumpInto(std::move(source), buffer);
+
+    timer.start(duration);
+    while (true) {
+        while (!elapsed && !buffer->isFull() && !buffer->isFinished() && !buffer->hasException()) {
+            co_await buffer->changed();
+        }
+        buffer->rethrowIfException();
+
+        auto batch = buffer->takeAll();
+        const bool finished = buffer->isFinished() && buffer->isEmpty();
+        if (!batch.empty()) {
+            co_yield std::move(batch);
+        }
+        if (finished) {
+            break;
+        }
+
+        elapsed = false;
+        timer.start(duration);
+    }
+}
+
+//! Consumes all the \c sources concurrently, letting them run up to \c capacity values ahead.
+template<typename T>
+AsyncGenerator<async_generator_value_t<T>> bufferedGenerator(std::vector<AsyncGenerator<T>> sources,
+                                                             std::size_t capacity) {
+    using V = async_generator_value_t<T>;
+    auto buffer = std::make_shared<AsyncGeneratorBuffer<V>>(capacity);
+    const auto closeGuard = qScopeGuard([&buffer]() { buffer->close(); });
+
+    for (auto &source : sources) {
+        buffer->addProducer();
+        pumpInto(std::move(source), buffer);
+    }
+    sources.clear();
+
+    while (true) {
+        while (buffer->isEmpty() && !buffer->isFinished() && !buffer->hasException()) {
+            co_await buffer->changed();
+        }
+
+        // Values produced before an exception are delivered first
+        auto value = buffer->pop();
+        if (!value.has_value()) {
+            buffer->rethrowIfException();
+            break;
+        }
+        co_yield std::move(*value);
+    }
+}
+
+template<typename T, typename U>
+AsyncGenerator<std::pair<async_generator_value_t<T>, async_generator_value_t<U>>>
+zipGenerators(AsyncGenerator<T> first, AsyncGenerator<U> second) {
+    auto firstIt = co_await first.begin();
+    if (firstIt == first.end()) {
+        co_return;
+    }
+    auto secondIt = co_await second.begin();
+    while (secondIt != second.end()) {
+        auto value = std::make_pair(takeValue(firstIt), takeValue(secondIt));
+        co_yield std::move(value);
+
+        co_await ++firstIt;
+        if (firstIt == first.end()) {
+            break;
+        }
+        co_await ++secondIt;
+    }
+}
+
+//! Results of parallelMap() workers, shared between the worker threads and the consumer.
+/*!
+ * Workers push their results into the queue and notify the consumer by posting the notification
+ * callback into the consumer's thread through the receiver object. Only one notification is
+ * posted until the consumer takes the results. Once the consumer is gone it detaches from the
+ * state and results of the remaining workers are discarded.
+ */
+template<typename R>
+class ParallelMapState {
+public:
+    struct Result {
+        std::size_t index;
+        std::optional<R> value;
+        std::exception_ptr exception;
+    };
+
+    ParallelMapState(QObject *receiver, std::function<void()> notify)
+        : mReceiver(receiver), mNotify(std::move(notify)) {}
+    Q_DISABLE_COPY(ParallelMapState)
+
+    //! Called from a worker thread when a result is ready.
+    void complete(Result &&result) {
+        const QMutexLocker locker(&mMutex);
+        if (!mReceiver) {
+            return;
+        }
+        mResults.push_back(std::move(result));
+        if (!std::exchange(mNotifyPending, true)) {
+            QMetaObject::invokeMethod(mReceiver, mNotify, Qt::QueuedConnection);
+        }
+    }
+
+    //! Called from the consumer thread to take all ready results.
+    std::vector<Result> takeResults() {
+        const QMutexLocker locker(&mMutex);
+        mNotifyPending = false;
+        return std::exchange(mResults, {});
+    }
+
+    //! Called from the consumer thread before the receiver is destroyed.
+    void detach() {
+        const QMutexLocker locker(&mMutex);
+        mReceiver = nullptr;
+        mResults.clear();
+    }
+
+private:
+    QMutex mMutex;
+    QObject *mReceiver;
+    std::function<void()> mNotify;
+    std::vector<Result> mResults;
+    bool mNotifyPending = false;
+};
+
+//! Runnable invoking the parallelMap() function for a single value in a worker thread.
+template<typename Fn, typename V, typename R>
+class ParallelMapRunnable final : public QRunnable {
+public:
+    ParallelMapRunnable(std::shared_ptr<Fn> fn, V &&value, std::size_t index,
+                        std::shared_ptr<ParallelMapState<R>> state)
+        : mFn(std::move(fn)), mValue(std::move(value)), mIndex(index), mState(std::move(state)) {}
+
+    void run() override {
+        typename ParallelMapState<R>::Result result{mIndex, std::nullopt, nullptr};
+        try {
+            result.value.emplace(std::invoke(*mFn, std::move(mValue)));
+        } catch (...) {
+            result.exception = std::current_exception();
+        }
+        mState->complete(std::move(result));
+    }
+
+private:
+    std::shared_ptr<Fn> mFn;
+    V mValue;
+    std::size_t mIndex;
+    std::shared_ptr<ParallelMapState<R>> mState;
+};
+
+template<typename T, typename Fn>
+using parallel_map_result_t = std::remove_cvref_t<std::invoke_result_t<Fn &, async_generator_value_t<T> &&>>;
+
+template<typename T, typename Fn>
+AsyncGenerator<parallel_map_result_t<T, Fn>> parallelMapGenerator(AsyncGenerator<T> source, Fn fn,
+                                                                  std::size_t concurrency, ResultOrder order,
+                                                                  QThreadPool *pool) {
+    using V = async_generator_value_t<T>;
+    using R = parallel_map_result_t<T, Fn>;
+    using State = ParallelMapState<R>;
+
+    // The source generator is consumed concurrently, so that new values can be dispatched to
+    // the pool while the consumer waits for results and vice versa.
+    auto input = std::make_shared<AsyncGeneratorBuffer<V>>(concurrency);
+    const auto closeGuard = qScopeGuard([&input]() { input->close(); });
+
+    // Results are delivered into this thread through the receiver. Pending notifications are
+    // discarded when the receiver is destroyed together with this coroutine frame.
+    QObject receiver;
+    auto state = std::make_shared<State>(&receiver, [buffer = input.get()]() { buffer->wakeConsumer(); });
+    const auto detachGuard = qScopeGuard([&state]() { state->detach(); });
+    const auto sharedFn = std::make_shared<Fn>(std::move(fn));
+
+    input->addProducer();
+    pumpInto(std::move(source), input);
+
+    std::deque<typename State::Result> completed;
+    std::size_t inFlight = 0;
+    std::size_t nextIndex = 0;
+    std::size_t nextResult = 0;
+    while (true) {
+        while (inFlight < concurrency) {
+            auto value = input->pop();
+            if (!value.has_value()) {
+                break;
+            }
+            pool->start(new ParallelMapRunnable<Fn, V, R>(sharedFn, std::move(*value), nextIndex++, state));
+            ++inFlight;
+        }
+
+        for (auto &result : state->takeResults()) {
+            completed.push_back(std::move(result));
+        }
+        auto next = completed.begin();
+        if (order == ResultOrder::InputOrder) {
+            next = std::find_if(completed.begin(), completed.end(),
+                                [nextResult](const auto &result) { return result.index == nextResult; });
+        }
+        if (next != completed.end()) {
+            auto result = std::move(*next);
+            completed.erase(next);
+            --inFlight;
+            ++nextResult;
+            if (result.exception) {
+                std::rethrow_exception(result.exception);
+            }
+            co_yield std::move(*result.value);
+            continue;
+        }
+
+        if (inFlight == 0 && input->isEmpty() && input->isFinished()) {
+            input->rethrowIfException();
+            break;
+        }
+        co_await input->changed();
+    }
+}
+
+template<typename T>
+auto mergeGenerators(std::vector<AsyncGenerator<T>> sources) {
+    // Each source can run one value ahead of the consumer.
+    const auto capacity = std::max<std::size_t>(sources.size(), 1);
+    return bufferedGenerator(std::move(sources), capacity);
+}
+
+class ChunkOperator : public GeneratorOperator {
+public:
+    explicit ChunkOperator(std::size_t size)
+        : mSize(size) {
+        Q_ASSERT(size > 0);
+    }
+
+    template<typename T>
+    auto operator()(AsyncGenerator<T> &&source) const {
+        return chunkGenerator(std::move(source), mSize);
+    }
+
+private:
+    std::size_t mSize;
+};
+
+class WindowOperator : public GeneratorOperator {
+public:
+    explicit WindowOperator(std::chrono::milliseconds duration, std::size_t maxSize)
+        : mDuration(duration), mMaxSize(maxSize) {}
+
+    template<typename T>
+    auto operator()(AsyncGenerator<T> &&source) const {
+        return windowGenerator(std::move(source), mDuration, mMaxSize);
+    }
+
+private:
+    std::chrono::milliseconds mDuration;
+    std::size_t mMaxSize;
+};
+
+class PrefetchOperator : public GeneratorOperator {
+public:
+    explicit PrefetchOperator(std::size_t count)
+        : mCount(count) {
+        Q_ASSERT(count > 0);
+    }
+
+    template<typename T>
+    auto operator()(AsyncGenerator<T> &&source) const {
+        std::vector<AsyncGenerator<T>> sources;
+        sources.push_back(std::move(source));
+        return bufferedGenerator(std::move(sources), mCount);
+    }
+
+private:
+    std::size_t mCount;
+};
+
+template<typename Fn>
+class ParallelMapOperator : public GeneratorOperator {
+public:
+    ParallelMapOperator(Fn fn, std::size_t concurrency, ResultOrder order, QThreadPool *pool)
+        : mFn(std::move(fn)), mConcurrency(concurrency), mOrder(order), mPool(pool) {
+        Q_ASSERT(concurrency > 0);
+    }
+
+    template<typename T>
+    auto operator()(AsyncGenerator<T> &&source) const {
+        return parallelMapGenerator(std::move(source), mFn, mConcurrency, mOrder, mPool);
+    }
+
+private:
+    Fn mFn;
+    std::size_t mConcurrency;
+    ResultOrder mOrder;
+    QThreadPool *mPool;
+};
+
+} // namespace detail
+
+/*! \endcond */
+
+//! A lazy chain of fused adaptors applied to an AsyncGenerator.
+/*!
+ * The pipeline is created by applying any of the fusable adaptors (QCoro::map(), QCoro::filter()
+ * or QCoro::take()) to an AsyncGenerator<T> using the `|` operator. Applying another fusable
+ * adaptor to the pipeline doesn't create a new generator coroutine, instead the adaptor is
+ * fused with the existing ones, so that the whole pipeline runs in a single coroutine frame
+ * and each value is passed through all the stages without any additional suspension.
+ *
+ * The pipeline can be iterated just like an AsyncGenerator (including QCORO_FOREACH), or
+ * converted into an AsyncGenerator<value_type>.
+ *
+ * @code
+ * auto numbers = qCoroSignalListener(socket, &Socket::messageReceived)
+ *              | QCoro::map([](const Message &msg) { return msg.number(); })
+ *              | QCoro::filter([](int number) { return number % 2 == 0; })
+ *              | QCoro::take(10);
+ * QCORO_FOREACH(int number, numbers) {
+ *     ...
+ * }
+ * @endcode
+ */
+template<typename T, typename Stage>
+class [[nodiscard]] AsyncGeneratorPipeline {
+public:
+    //! Type of values produced by the pipeline.
+    using value_type = typename std::invoke_result_t<Stage &, typename QCoro::AsyncGeneratorIterator<T>::reference, bool &>::value_type;
+    //! Type of generator this pipeline turns into.
+    using generator_type = AsyncGenerator<value_type>;
+    using iterator = typename generator_type::iterator;
+
+    AsyncGeneratorPipeline(AsyncGenerator<T> &&source, Stage &&stage)
+        : mSource(std::move(source)), mStage(std::move(stage)) {}
+
+    //! Turns the pipeline into an AsyncGenerator.
+    generator_type generator() && {
+        return detail::runPipeline<value_type>(std::move(mSource), std::move(mStage));
+    }
+
+    //! \copydoc generator()
+    operator generator_type() && { // NOLINT(google-explicit-constructor)
+        return std::move(*this).generator();
+    }
+
+    //! Starts the pipeline and returns an awaitable resolving to the first value.
+    /*!
+     * \see AsyncGenerator<T>::begin()
+     */
+    auto begin() {
+        if (!mGenerator.has_value()) {
+            mGenerator.emplace(std::move(*this).generator());
+        }
+        return mGenerator->begin();
+    }
+
+    //! Returns an iterator representing the finished pipeline.
+    constexpr iterator end() const noexcept {
+        return iterator{nullptr};
+    }
+
+    //! Fuses the pipeline with another stage.
+    template<typename NextStage>
+    friend auto operator|(AsyncGeneratorPipeline &&pipeline, detail::StageOperator<NextStage> op) {
+        using Composed = detail::ComposedStage<Stage, NextStage>;
+        return AsyncGeneratorPipeline<T, Composed>(std::move(pipeline.mSource),
+                                                   Composed{std::move(pipeline.mStage), std::move(op.stage)});
+    }
+
+    //! Materializes the pipeline and applies a non-fusable adaptor to it.
+    template<detail::generator_operator Op>
+    friend auto operator|(AsyncGeneratorPipeline &&pipeline, const Op &op) {
+        return op(std::move(pipeline).generator());
+    }
+
+private:
+    AsyncGenerator<T> mSource;
+    Stage mStage;
+    std::optional<generator_type> mGenerator;
+};
+
+//! Applies a fusable adaptor to the generator.
+template<typename T, typename Stage>
+auto operator|(AsyncGenerator<T> &&source, detail::StageOperator<Stage> op) {
+    return AsyncGeneratorPipeline<T, Stage>(std::move(source), std::move(op.stage));
+}
+
+//! Applies a non-fusable adaptor to the generator.
+template<typename T, detail::generator_operator Op>
+auto operator|(AsyncGenerator<T> &&source, const Op &op) {
+    return op(std::move(source));
+}
+
+//! Transforms each value produced by the generator using function \c fn.
+template<typename Fn>
+auto map(Fn &&fn) {
+    return detail::StageOperator<detail::MapStage<std::decay_t<Fn>>>{
+        detail::MapStage<std::decay_t<Fn>>{std::forward<Fn>(fn)}};
+}
+
+//! Only passes through values for which the \c predicate returns true.
+template<typename Predicate>
+auto filter(Predicate &&predicate) {
+    return detail::StageOperator<detail::FilterStage<std::decay_t<Predicate>>>{
+        detail::FilterStage<std::decay_t<Predicate>>{std::forward<Predicate>(predicate)}};
+}
+
+//! Finishes after \c count values have been produced.
+inline auto take(std::size_t count) {
+    return detail::StageOperator<detail::TakeStage>{detail::TakeStage{count}};
+}
+
+//! Groups values into vectors of \c size values.
+/*!
+ * The last chunk may contain fewer values if the source generator finishes before the
+ * chunk is full.
+ */
+inline auto chunk(std::size_t size) {
+    return detail::ChunkOperator{size};
+}
+
+//! Groups values produced within each time window into vectors.
+/*!
+ * A batch is produced every time the \c duration elapses (unless no values were produced
+ * in the meantime) or as soon as \c maxSize values are collected, if non-zero. The source
+ * generator is consumed concurrently with the consumer, so the window closes on time even
+ * if the source generator is suspended.
+ *
+ * The timer requires a running event loop in the current thread.
+ */
+template<typename Rep, typename Period>
+auto window(std::chrono::duration<Rep, Period> duration, std::size_t maxSize = 0) {
+    return detail::WindowOperator{std::chrono::duration_cast<std::chrono::milliseconds>(duration), maxSize};
+}
+
+//! Lets the source generator run up to \c count values ahead of the consumer.
+/*!
+ * The source generator is consumed concurrently with the consumer and the produced values
+ * are stored in a buffer of \c count values, so that latency in the producer (e.g. waiting
+ * for the next page of a network download) overlaps with processing in the consumer. The
+ * source generator is suspended when the buffer is full and resumed as soon as the consumer
+ * takes a value from the buffer. Exceptions thrown by the source generator are rethrown to
+ * the consumer after it consumes all the values produced before the exception.
+ */
+inline auto prefetch(std::size_t count) {
+    return detail::PrefetchOperator{count};
+}
+
+//! Interleaves values from all generators in the order in which they are produced.
+/*!
+ * All the generators are consumed concurrently, each one can run at most one value ahead
+ * of the consumer. The resulting generator finishes when all the source generators finish.
+ * If any of the source generators throws an exception, the other generators are no longer
+ * consumed and the exception is rethrown to the consumer once it consumes the values produced
+ * before the exception.
+ */
+template<typename T, typename... Ts>
+requires (std::is_same_v<T, Ts> && ...)
+auto merge(AsyncGenerator<T> &&first, AsyncGenerator<Ts> &&...rest) {
+    std::vector<AsyncGenerator<T>> sources;
+    sources.reserve(sizeof...(Ts) + 1);
+    sources.push_back(std::move(first));
+    (sources.push_back(std::move(rest)), ...);
+    return detail::mergeGenerators(std::move(sources));
+}
+
+//! Combines values produced by two generators into pairs.
+/*!
+ * The resulting generator finishes as soon as any of the source generators finishes.
+ */
+template<typename T, typename U>
+auto zip(AsyncGenerator<T> &&first, AsyncGenerator<U> &&second) {
+    return detail::zipGenerators(std::move(first), std::move(second));
+}
+
+//! Transforms each value produced by the generator using function \c fn in a thread pool.
+/*!
+ * Each value is moved into a worker thread of the \c pool (the global thread pool by default)
+ * where \c fn is invoked with it. At most \c concurrency values are processed at the same time.
+ * The results are produced in the thread of the consumer, either in the order of the source
+ * values or in the order in which they are computed, depending on \c order.
+ *
+ * The function is shared by all the workers, so it must be safe to invoke it concurrently.
+ * If the function throws an exception, it's rethrown to the consumer. If the generator is
+ * destroyed while some values are still being processed, their results are discarded.
+ *
+ * Delivering results to the consumer requires a running event loop in the consumer's thread.
+ */
+template<typename Fn>
+auto parallelMap(Fn &&fn, std::size_t concurrency = std::max(QThread::idealThreadCount(), 1),
+                 ResultOrder order = ResultOrder::InputOrder, QThreadPool *pool = QThreadPool::globalInstance()) {
+    return detail::ParallelMapOperator<std::decay_t<Fn>>{std::forward<Fn>(fn), concurrency, order, pool};
+}
+
+//! \copydoc parallelMap(Fn &&fn, std::size_t concurrency, ResultOrder order, QThreadPool *pool)
+template<typename T, typename Fn>
+auto parallelMap(AsyncGenerator<T> &&source, Fn &&fn,
+                 std::size_t concurrency = std::max(QThread::idealThreadCount(), 1),
+                 ResultOrder order = ResultOrder::InputOrder, QThreadPool *pool = QThreadPool::globalInstance()) {
+    return std::move(source) | parallelMap(std::forward<Fn>(fn), concurrency, order, pool);
+}
+
+} // namespace QCoro
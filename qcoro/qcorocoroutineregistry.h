@@ -0,0 +1,414 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorocore_export.h"
+
+#include <QtGlobal>
+#include <QDebug>
+#include <QString>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_DARWIN)
+#include <time.h>
+#endif
+
+namespace QCoro {
+
+//! Location in the source code.
+struct CoroutineLocation {
+    const char *fileName = "";
+    const char *functionName = "";
+    std::uint_least32_t line = 0;
+    std::uint_least32_t column = 0;
+};
+
+//! Information about a single live coroutine.
+struct CoroutineInfo {
+    enum class State {
+        Created,   //!< The coroutine has been created, but hasn't started running yet.
+        Running,   //!< The coroutine is running.
+        Suspended, //!< The coroutine is suspended in a co_await.
+        Finished,  //!< The coroutine has finished, but its result hasn't been consumed yet.
+    };
+
+    //! Location of the coroutine function, \c functionName identifies the coroutine.
+    CoroutineLocation creationSite;
+    //! Location of the last co_await of the coroutine, \c line is 0 if the coroutine hasn't co_awaited yet.
+    CoroutineLocation suspensionPoint;
+    //! Name of the type of the last co_awaited object.
+    std::string_view awaitedType;
+    //! Address of the last co_awaited object.
+    /*!
+     * The object is only guaranteed to be alive while the coroutine is suspended on it. For
+     * a co_awaited QObject, like a QTimer, this is the address of the QObject itself.
+     */
+    const void *awaitedObject = nullptr;
+    //! Current state of the coroutine.
+    State state = State::Created;
+    //! For how long the coroutine has been suspended, zero if it's not suspended.
+    std::chrono::steady_clock::duration suspendedFor{};
+    //! Address of the coroutine frame.
+    const void *frame = nullptr;
+    //! Address of the frame of the coroutine that co_awaits this coroutine, if any.
+    const void *awaitingFrame = nullptr;
+};
+
+/*! \cond internal */
+
+namespace detail::registry {
+
+using Location = std::source_location;
+
+//! Returns the name of the type \c T, without relying on RTTI.
+template<typename T>
+std::string_view typeName() noexcept {
+#if defined(Q_CC_MSVC)
+    constexpr std::string_view signature = __FUNCSIG__;
+    constexpr std::string_view prefix = "typeName<";
+    constexpr std::string_view suffix = ">(void)";
+#else
+    constexpr std::string_view signature = __PRETTY_FUNCTION__;
+    constexpr std::string_view prefix = "T = ";
+    constexpr std::string_view suffix = ";]";
+#endif
+    const auto start = signature.find(prefix);
+    if (start == std::string_view::npos) {
+        return signature;
+    }
+    auto name = signature.substr(start + prefix.size());
+#if defined(Q_CC_MSVC)
+    return name.substr(0, name.rfind(suffix));
+#else
+    return name.substr(0, name.find_first_of(suffix));
+#endif
+}
+
+//! Monotonic clock used to timestamp suspensions.
+/*!
+ * The registry only reports suspensions with millisecond precision, so where available, a coarse
+ * clock is used, which is cheaper to read than std::chrono::steady_clock on every co_await.
+ */
+struct SuspensionClock {
+    static std::chrono::nanoseconds now() noexcept {
+#if defined(Q_OS_LINUX)
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+#elif defined(Q_OS_DARWIN)
+        return std::chrono::nanoseconds(clock_gettime_nsec_np(CLOCK_UPTIME_RAW_APPROX));
+#else
+        return std::chrono::steady_clock::now().time_since_epoch();
+#endif
+    }
+};
+
+class CoroutineEntry;
+
+//! List of all live coroutines.
+/*!
+ * The coroutines are spread over multiple lists, each guarded by its own mutex. Each thread
+ * registers its coroutines in one of the lists, so that threads creating and destroying
+ * coroutines concurrently don't contend on a single lock.
+ */
+class Registry {
+public:
+    //! Returns the registry. It's never destroyed, since coroutine frames can outlive static destructors.
+    /*!
+     * The registry is stored in QCoroCore, so that coroutines compiled into the application and
+     * into the QCoro libraries are all registered together, even when each of them is a DLL.
+     */
+    QCOROCORE_EXPORT static Registry &instance();
+
+    void add(CoroutineEntry *entry) noexcept;
+    void remove(CoroutineEntry *entry) noexcept;
+    std::vector<CoroutineInfo> coroutines() const;
+
+private:
+    Registry() = default;
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        CoroutineEntry *head = nullptr;
+    };
+
+    static constexpr std::size_t shardCount = 16;
+
+    std::array<Shard, shardCount> mShards;
+    std::atomic<std::size_t> mNextShard{0};
+};
+
+//! Registry entry of a single coroutine, owned by its promise.
+/*!
+ * The fields are atomic so that the registry can be read from any thread while the coroutine
+ * runs. The information is best-effort: a snapshot taken while the coroutine is being suspended
+ * or resumed may mix the old and the new suspension point.
+ */
+class CoroutineEntry {
+public:
+    explicit CoroutineEntry(Location creationSite) noexcept
+        : mCreationSite(creationSite) {
+        Registry::instance().add(this);
+    }
+
+    ~CoroutineEntry() {
+        Registry::instance().remove(this);
+    }
+
+    CoroutineEntry(const CoroutineEntry &) = delete;
+    CoroutineEntry &operator=(const CoroutineEntry &) = delete;
+
+    void setFrame(const void *frame) noexcept {
+        mFrame.store(frame, std::memory_order_relaxed);
+    }
+
+    void setAwaitingFrame(const void *frame) noexcept {
+        mAwaitingFrame.store(frame, std::memory_order_relaxed);
+    }
+
+    template<typename Awaitable>
+    void awaiting(const Awaitable &awaitable, Location location) noexcept {
+        const auto type = typeName<Awaitable>();
+        mAwaitedObject.store(std::addressof(awaitable), std::memory_order_relaxed);
+        mFile.store(location.file_name(), std::memory_order_relaxed);
+        mFunction.store(location.function_name(), std::memory_order_relaxed);
+        mLine.store(location.line(), std::memory_order_relaxed);
+        mColumn.store(location.column(), std::memory_order_relaxed);
+        mAwaitedType.store(type.data(), std::memory_order_relaxed);
+        mAwaitedTypeSize.store(type.size(), std::memory_order_relaxed);
+    }
+
+    void resumed() noexcept {
+        mState.store(CoroutineInfo::State::Running, std::memory_order_relaxed);
+    }
+
+    void suspended() noexcept {
+        mSuspendedAt.store(SuspensionClock::now().count(), std::memory_order_relaxed);
+        mState.store(CoroutineInfo::State::Suspended, std::memory_order_relaxed);
+    }
+
+    void finished() noexcept {
+        // The awaiting coroutine is resumed now, but it may still hold the finished Task
+        mAwaitingFrame.store(nullptr, std::memory_order_relaxed);
+        mState.store(CoroutineInfo::State::Finished, std::memory_order_relaxed);
+    }
+
+    CoroutineInfo info(std::chrono::nanoseconds now) const;
+
+private:
+    friend class Registry;
+
+    const Location mCreationSite;
+    std::atomic<const void *> mFrame{nullptr};
+    std::atomic<const void *> mAwaitingFrame{nullptr};
+    std::atomic<const char *> mFile{nullptr};
+    std::atomic<const char *> mFunction{nullptr};
+    std::atomic<std::uint_least32_t> mLine{0};
+    std::atomic<std::uint_least32_t> mColumn{0};
+    std::atomic<const char *> mAwaitedType{nullptr};
+    std::atomic<std::size_t> mAwaitedTypeSize{0};
+    std::atomic<const void *> mAwaitedObject{nullptr};
+    std::atomic<CoroutineInfo::State> mState{CoroutineInfo::State::Created};
+    std::atomic<std::chrono::nanoseconds::rep> mSuspendedAt{0};
+
+    // Set when registered, the rest is guarded by the mutex of the shard
+    std::size_t mShard = 0;
+    CoroutineEntry *mPrev = nullptr;
+    CoroutineEntry *mNext = nullptr;
+};
+
+inline CoroutineInfo CoroutineEntry::info(std::chrono::nanoseconds now) const {
+    CoroutineInfo info;
+    info.creationSite = {mCreationSite.file_name(), mCreationSite.function_name(), mCreationSite.line(),
+                         mCreationSite.column()};
+    if (const char *file = mFile.load(std::memory_order_relaxed); file != nullptr) {
+        info.suspensionPoint = {file, mFunction.load(std::memory_order_relaxed), mLine.load(std::memory_order_relaxed),
+                                mColumn.load(std::memory_order_relaxed)};
+    }
+    info.state = mState.load(std::memory_order_relaxed);
+    info.frame = mFrame.load(std::memory_order_relaxed);
+    info.awaitingFrame = mAwaitingFrame.load(std::memory_order_relaxed);
+    if (const char *type = mAwaitedType.load(std::memory_order_relaxed); type != nullptr) {
+        info.awaitedType = std::string_view(type, mAwaitedTypeSize.load(std::memory_order_relaxed));
+    }
+    info.awaitedObject = mAwaitedObject.load(std::memory_order_relaxed);
+    if (info.state == CoroutineInfo::State::Suspended) {
+        const std::chrono::nanoseconds suspendedAt{mSuspendedAt.load(std::memory_order_relaxed)};
+        info.suspendedFor = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::max(now - suspendedAt, std::chrono::nanoseconds::zero()));
+    }
+    return info;
+}
+
+inline void Registry::add(CoroutineEntry *entry) noexcept {
+    static thread_local const std::size_t threadShard =
+        mNextShard.fetch_add(1, std::memory_order_relaxed) % shardCount;
+    entry->mShard = threadShard;
+
+    // The coroutine may be destroyed in another thread, so the shard still needs a lock
+    auto &shard = mShards[threadShard];
+    std::lock_guard lock(shard.mutex);
+    entry->mNext = shard.head;
+    if (shard.head) {
+        shard.head->mPrev = entry;
+    }
+    shard.head = entry;
+}
+
+inline void Registry::remove(CoroutineEntry *entry) noexcept {
+    auto &shard = mShards[entry->mShard];
+    std::lock_guard lock(shard.mutex);
+    if (entry->mPrev) {
+        entry->mPrev->mNext = entry->mNext;
+    } else {
+        shard.head = entry->mNext;
+    }
+    if (entry->mNext) {
+        entry->mNext->mPrev = entry->mPrev;
+    }
+}
+
+inline std::vector<CoroutineInfo> Registry::coroutines() const {
+    const auto now = SuspensionClock::now();
+    std::vector<CoroutineInfo> coroutines;
+    for (const auto &shard : mShards) {
+        std::lock_guard lock(shard.mutex);
+        for (const auto *entry = shard.head; entry != nullptr; entry = entry->mNext) {
+            coroutines.push_back(entry->info(now));
+        }
+    }
+    return coroutines;
+}
+
+} // namespace detail::registry
+
+/*! \endcond */
+
+//! Registry of all live QCoro::Task and QCoro::LazyTask coroutines.
+/*!
+ * Coroutines are only registered when QCoro is built with the \c QCORO_ENABLE_COROUTINE_REGISTRY
+ * CMake option, otherwise the registry is always empty.
+ */
+namespace CoroutineRegistry {
+
+//! Returns whether the coroutines are registered in this build.
+constexpr bool isEnabled() {
+#ifdef QCORO_COROUTINE_REGISTRY
+    return true;
+#else
+    return false;
+#endif
+}
+
+//! Returns information about all live coroutines.
+inline std::vector<CoroutineInfo> coroutines() {
+    return detail::registry::Registry::instance().coroutines();
+}
+
+//! Returns the async stacks of all live coroutines.
+/*!
+ * Like a regular stack trace, each async stack starts with the innermost coroutine, which isn't
+ * co_awaiting any other coroutine, and continues with the coroutine that co_awaits it, up to the
+ * outermost coroutine that isn't co_awaited by any other coroutine. If a coroutine is co_awaited
+ * by multiple coroutines, only the last one is followed.
+ */
+inline std::vector<std::vector<CoroutineInfo>> asyncStacks() {
+    const auto coroutines = CoroutineRegistry::coroutines();
+
+    std::unordered_map<const void *, const CoroutineInfo *> byFrame;
+    // Frames of the coroutines that are co_awaiting another coroutine
+    std::unordered_set<const void *> awaitingFrames;
+    for (const auto &coroutine : coroutines) {
+        if (coroutine.frame) {
+            byFrame.emplace(coroutine.frame, &coroutine);
+        }
+        if (coroutine.awaitingFrame) {
+            awaitingFrames.insert(coroutine.awaitingFrame);
+        }
+    }
+
+    std::vector<std::vector<CoroutineInfo>> stacks;
+    for (const auto &coroutine : coroutines) {
+        // Only start with the innermost coroutines
+        if (coroutine.state == CoroutineInfo::State::Finished || awaitingFrames.contains(coroutine.frame)) {
+            continue;
+        }
+
+        auto &stack = stacks.emplace_back();
+        const CoroutineInfo *current = &coroutine;
+        // The size limit protects against cycles from stale frame addresses
+        while (current != nullptr && stack.size() <= coroutines.size()) {
+            stack.push_back(*current);
+            const auto parent = byFrame.find(current->awaitingFrame);
+            current = parent == byFrame.end() ? nullptr : parent->second;
+        }
+    }
+    return stacks;
+}
+
+//! Prints the async stacks of all live coroutines using qInfo().
+/*!
+ * ```
+ * QCoro: 2 live coroutines
+ * Async stack #0:
+ *   #0 QCoro::Task<QByteArray> readRequest(QTcpSocket *), suspended for 1520 ms at server.cpp:42 in co_await QCoro::Task<bool> (0x5581e2b0c2a0)
+ *   #1 QCoro::Task<> handleClient(QTcpSocket *), suspended for 1520 ms at server.cpp:57 in co_await QCoro::Task<QByteArray> (0x5581e2b0c8f0)
+ * ```
+ */
+inline void dump() {
+    const auto stacks = asyncStacks();
+    std::size_t count = 0;
+    for (const auto &stack : stacks) {
+        count += stack.size();
+    }
+    qInfo().noquote() << QStringLiteral("QCoro: %1 live coroutines").arg(static_cast<qulonglong>(count));
+
+    for (std::size_t i = 0; i < stacks.size(); ++i) {
+        qInfo().noquote() << QStringLiteral("Async stack #%1:").arg(static_cast<qulonglong>(i));
+        for (std::size_t depth = 0; depth < stacks[i].size(); ++depth) {
+            const auto &coroutine = stacks[i][depth];
+            QString state;
+            switch (coroutine.state) {
+            case CoroutineInfo::State::Created:
+                state = QStringLiteral("not started yet");
+                break;
+            case CoroutineInfo::State::Running:
+                state = QStringLiteral("running");
+                break;
+            case CoroutineInfo::State::Suspended:
+                state = QStringLiteral("suspended for %1 ms at %2:%3 in co_await %4 (0x%5)")
+                            .arg(static_cast<qint64>(std::chrono::duration_cast<std::chrono::milliseconds>(coroutine.suspendedFor).count()))
+                            .arg(QString::fromUtf8(coroutine.suspensionPoint.fileName))
+                            .arg(coroutine.suspensionPoint.line)
+                            .arg(QString::fromUtf8(coroutine.awaitedType.data(),
+                                                   static_cast<qsizetype>(coroutine.awaitedType.size())))
+                            .arg(reinterpret_cast<quintptr>(coroutine.awaitedObject), 0, 16);
+                break;
+            case CoroutineInfo::State::Finished:
+                state = QStringLiteral("finished");
+                break;
+            }
+            qInfo().noquote() << QStringLiteral("  #%1 %2, %3")
+                                     .arg(static_cast<qulonglong>(depth))
+                                     .arg(QString::fromUtf8(coroutine.creationSite.functionName), state);
+        }
+    }
+}
+
+} // namespace CoroutineRegistry
+
+} // namespace QCoro
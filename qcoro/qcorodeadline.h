@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "coroutine.h"
+#include "qcorocore_export.h"
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <utility>
+
+namespace QCoro {
+
+/*! \cond internal */
+
+namespace detail {
+
+using DeadlineClock = std::chrono::steady_clock;
+
+//! Deadline of the coroutine that is currently running in this thread.
+/*!
+ * DeadlineClock::time_point::max() means there's no deadline.
+ *
+ * The deadline is stored in QCoroCore, so that the application and all the QCoro libraries
+ * share it even when each of them is a separate shared library. Thread-local variables cannot
+ * be imported from a DLL on Windows, so there it's only accessible through a function call.
+ */
+#ifdef Q_OS_WIN
+QCOROCORE_EXPORT DeadlineClock::time_point &threadDeadline() noexcept;
+#else
+extern QCOROCORE_EXPORT constinit thread_local DeadlineClock::time_point currentThreadDeadline;
+
+inline DeadlineClock::time_point &threadDeadline() noexcept {
+    return currentThreadDeadline;
+}
+#endif
+
+//! Deadline of a single coroutine.
+/*!
+ * The deadline is inherited from the coroutine that was running when this coroutine was
+ * created. Whenever the coroutine is resumed, it installs its deadline as the current deadline
+ * of the thread, and whenever it suspends, it restores the deadline of whoever resumed it.
+ * The deadline of the thread is left untouched until the coroutine starts running.
+ */
+class DeadlineContext {
+public:
+    DeadlineContext() noexcept
+        : mDeadline(threadDeadline()), mOuterDeadline(mDeadline) {}
+
+    void resumed() noexcept {
+        mOuterDeadline = std::exchange(threadDeadline(), mDeadline);
+    }
+
+    void suspended() const noexcept {
+        threadDeadline() = mOuterDeadline;
+    }
+
+    //! Deadline of whoever resumed the coroutine, restored by suspended().
+    DeadlineClock::time_point outerDeadline() const noexcept {
+        return mOuterDeadline;
+    }
+
+    void tighten(DeadlineClock::time_point deadline) noexcept {
+        mDeadline = std::min(mDeadline, deadline);
+        threadDeadline() = mDeadline;
+    }
+
+private:
+    DeadlineClock::time_point mDeadline;
+    DeadlineClock::time_point mOuterDeadline;
+};
+
+//! Awaitable returned by QCoro::setDeadline().
+struct DeadlineRequest {
+    DeadlineClock::time_point deadline;
+};
+
+//! Returns the \c timeout shortened to the remaining time until the current deadline.
+/*!
+ * Negative \c timeout means no timeout.
+ */
+template<typename Duration>
+Duration timeoutWithDeadline(Duration timeout) {
+    const auto deadline = threadDeadline();
+    if (deadline == DeadlineClock::time_point::max()) {
+        return timeout;
+    }
+
+    const auto remaining = std::max(
+        std::chrono::ceil<Duration>(deadline - DeadlineClock::now()), Duration::zero());
+    return timeout < Duration::zero() ? remaining : std::min(timeout, remaining);
+}
+
+//! \copydoc timeoutWithDeadline(Duration)
+inline int timeoutWithDeadline(int timeout_msecs) {
+    return static_cast<int>(timeoutWithDeadline(std::chrono::milliseconds{timeout_msecs}).count());
+}
+
+} // namespace detail
+
+/*! \endcond */
+
+//! Sets the deadline of the current coroutine.
+/*!
+ * Must be co_awaited from a QCoro::Task coroutine. The deadline is inherited by all coroutines
+ * started from this coroutine and all QCoro operations that accept a timeout time out at the
+ * deadline at the latest. The deadline can only be tightened: setting a deadline later than
+ * the current one has no effect.
+ *
+ * ```cpp
+ * QCoro::Task<> handleRequest(QTcpSocket *socket) {
+ *     co_await QCoro::setDeadline(std::chrono::steady_clock::now() + 5s);
+ *     const auto request = co_await readRequest(socket); // Times out after 5 seconds at most
+ *     ...
+ * }
+ * ```
+ */
+inline detail::DeadlineRequest setDeadline(std::chrono::steady_clock::time_point deadline) {
+    return {deadline};
+}
+
+//! Sets the deadline of the current coroutine to \c timeout from now.
+/*!
+ * \copydetails setDeadline()
+ */
+template<typename Rep, typename Period>
+detail::DeadlineRequest setTimeout(std::chrono::duration<Rep, Period> timeout) {
+    return {std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout)};
+}
+
+//! Returns the deadline of the current coroutine, if any.
+inline std::optional<std::chrono::steady_clock::time_point> currentDeadline() {
+    const auto deadline = detail::threadDeadline();
+    if (deadline == detail::DeadlineClock::time_point::max()) {
+        return std::nullopt;
+    }
+    return deadline;
+}
+
+//! Returns the remaining time until the deadline of the current coroutine, if any.
+inline std::optional<std::chrono::milliseconds> remainingTime() {
+    const auto deadline = currentDeadline();
+    if (!deadline) {
+        return std::nullopt;
+    }
+    return std::max(std::chrono::ceil<std::chrono::milliseconds>(*deadline - std::chrono::steady_clock::now()),
+                    std::chrono::milliseconds::zero());
+}
+
+//! Sets the deadline for coroutines started from non-coroutine code within the scope.
+/*!
+ * ```cpp
+ * void Server::onNewConnection() {
+ *     QCoro::DeadlineScope deadline(std::chrono::steady_clock::now() + 5s);
+ *     handleRequest(mServer->nextPendingConnection()); // The request has 5 seconds to finish
+ * }
+ * ```
+ */
+class DeadlineScope {
+public:
+    explicit DeadlineScope(std::chrono::steady_clock::time_point deadline)
+        : mOuterDeadline(detail::threadDeadline()) {
+        detail::threadDeadline() = std::min(mOuterDeadline, deadline);
+    }
+    ~DeadlineScope() {
+        detail::threadDeadline() = mOuterDeadline;
+    }
+    DeadlineScope(const DeadlineScope &) = delete;
+    DeadlineScope &operator=(const DeadlineScope &) = delete;
+
+private:
+    std::chrono::steady_clock::time_point mOuterDeadline;
+};
+
+} // namespace QCoro
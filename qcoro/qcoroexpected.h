@@ -0,0 +1,308 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <concepts>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace QCoro {
+
+//! The error of a failed QCoro::Expected.
+/*!
+ * ```cpp
+ * QCoro::Expected<QByteArray, QString> loadFile(const QString &path) {
+ *     QFile file(path);
+ *     if (!file.open(QIODevice::ReadOnly)) {
+ *         return QCoro::Unexpected(file.errorString());
+ *     }
+ *     return file.readAll();
+ * }
+ * ```
+ */
+template<typename E>
+class Unexpected {
+public:
+    template<typename G = E>
+    requires std::constructible_from<E, G>
+    explicit Unexpected(G &&error)
+        : mError(std::forward<G>(error)) {}
+
+    const E &error() const & noexcept {
+        return mError;
+    }
+    E &error() & noexcept {
+        return mError;
+    }
+    E &&error() && noexcept {
+        return std::move(mError);
+    }
+
+    bool operator==(const Unexpected &other) const = default;
+
+private:
+    E mError;
+};
+
+template<typename E>
+Unexpected(E) -> Unexpected<E>;
+
+/*! \cond internal */
+
+namespace detail {
+
+template<typename T>
+struct isUnexpected : std::false_type {};
+
+template<typename E>
+struct isUnexpected<Unexpected<E>> : std::true_type {};
+
+} // namespace detail
+
+/*! \endcond */
+
+//! Exception thrown by Expected::value() when the Expected holds an error.
+template<typename E>
+class BadExpectedAccess : public std::exception {
+public:
+    explicit BadExpectedAccess(E error)
+        : mError(std::move(error)) {}
+
+    const char *what() const noexcept override {
+        return "Accessing the value of a QCoro::Expected that holds an error";
+    }
+
+    const E &error() const noexcept {
+        return mError;
+    }
+
+private:
+    E mError;
+};
+
+//! Either a value of type \c T or an error of type \c E.
+/*!
+ * A subset of C++23 `std::expected` that reports failures without throwing exceptions, which makes
+ * it cheap to return failures from coroutines: `Task<Expected<T, E>>` stores the error like any
+ * other value. Use QCORO_CO_TRY() to propagate the error from a co_awaited `Expected`.
+ *
+ * `Expected<void, E>` holds either nothing or an error.
+ */
+template<typename T, typename E>
+class Expected {
+public:
+    using value_type = T;
+    using error_type = E;
+
+    Expected() requires std::default_initializable<T>
+        : mStorage(std::in_place_index<0>) {}
+
+    template<typename U = T>
+    requires(std::constructible_from<T, U> && !std::same_as<std::remove_cvref_t<U>, Expected>
+             && !detail::isUnexpected<std::remove_cvref_t<U>>::value)
+    Expected(U &&value)
+        : mStorage(std::in_place_index<0>, std::forward<U>(value)) {}
+
+    template<typename G>
+    requires std::constructible_from<E, const G &>
+    Expected(const Unexpected<G> &error)
+        : mStorage(std::in_place_index<1>, error.error()) {}
+
+    template<typename G>
+    requires std::constructible_from<E, G>
+    Expected(Unexpected<G> &&error)
+        : mStorage(std::in_place_index<1>, std::move(error).error()) {}
+
+    bool has_value() const noexcept {
+        return mStorage.index() == 0;
+    }
+    explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    //! Returns the value, throws BadExpectedAccess<E> if the Expected holds an error.
+    const T &value() const & {
+        throwIfError();
+        return *std::get_if<0>(&mStorage);
+    }
+    T &value() & {
+        throwIfError();
+        return *std::get_if<0>(&mStorage);
+    }
+    T &&value() && {
+        throwIfError();
+        return std::move(*std::get_if<0>(&mStorage));
+    }
+
+    //! Returns the value, the Expected must not hold an error.
+    const T &operator*() const & noexcept {
+        Q_ASSERT(has_value());
+        return *std::get_if<0>(&mStorage);
+    }
+    T &operator*() & noexcept {
+        Q_ASSERT(has_value());
+        return *std::get_if<0>(&mStorage);
+    }
+    T &&operator*() && noexcept {
+        Q_ASSERT(has_value());
+        return std::move(*std::get_if<0>(&mStorage));
+    }
+    const T *operator->() const noexcept {
+        Q_ASSERT(has_value());
+        return std::get_if<0>(&mStorage);
+    }
+    T *operator->() noexcept {
+        Q_ASSERT(has_value());
+        return std::get_if<0>(&mStorage);
+    }
+
+    //! Returns the error, the Expected must hold an error.
+    const E &error() const & noexcept {
+        Q_ASSERT(!has_value());
+        return *std::get_if<1>(&mStorage);
+    }
+    E &error() & noexcept {
+        Q_ASSERT(!has_value());
+        return *std::get_if<1>(&mStorage);
+    }
+    E &&error() && noexcept {
+        Q_ASSERT(!has_value());
+        return std::move(*std::get_if<1>(&mStorage));
+    }
+
+    //! Returns the value, or the \c defaultValue if the Expected holds an error.
+    template<typename U>
+    T value_or(U &&defaultValue) const & {
+        return has_value() ? **this : static_cast<T>(std::forward<U>(defaultValue));
+    }
+    template<typename U>
+    T value_or(U &&defaultValue) && {
+        return has_value() ? std::move(**this) : static_cast<T>(std::forward<U>(defaultValue));
+    }
+
+    bool operator==(const Expected &other) const = default;
+
+private:
+    void throwIfError() const {
+        if (!has_value()) {
+            throw BadExpectedAccess<E>(error());
+        }
+    }
+
+    std::variant<T, E> mStorage;
+};
+
+//! Specialization of Expected for operations that produce no value.
+template<typename E>
+class Expected<void, E> {
+public:
+    using value_type = void;
+    using error_type = E;
+
+    Expected() noexcept = default;
+
+    template<typename G>
+    requires std::constructible_from<E, const G &>
+    Expected(const Unexpected<G> &error)
+        : mError(std::in_place, error.error()) {}
+
+    template<typename G>
+    requires std::constructible_from<E, G>
+    Expected(Unexpected<G> &&error)
+        : mError(std::in_place, std::move(error).error()) {}
+
+    bool has_value() const noexcept {
+        return !mError.has_value();
+    }
+    explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    //! Throws BadExpectedAccess<E> if the Expected holds an error.
+    void value() const {
+        if (!has_value()) {
+            throw BadExpectedAccess<E>(error());
+        }
+    }
+
+    //! Returns the error, the Expected must hold an error.
+    const E &error() const & noexcept {
+        Q_ASSERT(!has_value());
+        return *mError;
+    }
+    E &error() & noexcept {
+        Q_ASSERT(!has_value());
+        return *mError;
+    }
+    E &&error() && noexcept {
+        Q_ASSERT(!has_value());
+        return std::move(*mError);
+    }
+
+    bool operator==(const Expected &other) const = default;
+
+private:
+    std::optional<E> mError;
+};
+
+} // namespace QCoro
+
+/*! \cond internal */
+#define QCORO_TRY_CONCAT_IMPL(a, b) a##b
+#define QCORO_TRY_CONCAT(a, b) QCORO_TRY_CONCAT_IMPL(a, b)
+#define QCORO_CO_TRY_IMPL(result, var, ...)                                                        \
+    auto result = co_await (__VA_ARGS__);                                                          \
+    if (!result.has_value()) {                                                                     \
+        co_return QCoro::Unexpected(std::move(result).error());                                    \
+    }                                                                                              \
+    auto var = *std::move(result)
+/*! \endcond */
+
+//! Co_awaits an Expected and returns its error from the current coroutine if there's any.
+/*!
+ * The current coroutine must return a `Task<Expected<U, G>>`, where the error type \c G can be
+ * constructed from the error type of the co_awaited Expected. The error is propagated with
+ * `co_return`, so no exception is thrown.
+ *
+ * The macro expands to a single statement, so it can be used anywhere a function call can.
+ *
+ * ```cpp
+ * QCoro::Task<QCoro::Expected<void, QAbstractSocket::SocketError>> sendGreeting(QTcpSocket *socket) {
+ *     QCORO_CO_TRYV(qCoro(socket).tryConnectToHost(QStringLiteral("localhost"), 1234));
+ *     socket->write("Hello!");
+ *     co_return {};
+ * }
+ * ```
+ */
+#define QCORO_CO_TRYV(...)                                                                         \
+    do {                                                                                           \
+        auto qcoroTryResult = co_await (__VA_ARGS__);                                              \
+        if (!qcoroTryResult.has_value()) {                                                         \
+            co_return QCoro::Unexpected(std::move(qcoroTryResult).error());                        \
+        }                                                                                          \
+    } while (false)
+
+//! Co_awaits an Expected and declares a variable \c var initialized with its value.
+/*!
+ * If the co_awaited Expected holds an error, the error is returned from the current coroutine
+ * instead, see QCORO_CO_TRYV().
+ *
+ * Since the macro declares a variable in the current scope, it expands to several statements
+ * and must not be used as the body of an unbraced `if` or loop.
+ *
+ * ```cpp
+ * QCoro::Task<QCoro::Expected<int, QCoro::IOError>> readNumber(QIODevice *device) {
+ *     QCORO_CO_TRY(line, qCoro(device).tryReadLine());
+ *     co_return line.trimmed().toInt();
+ * }
+ * ```
+ */
+#define QCORO_CO_TRY(var, ...)                                                                     \
+    QCORO_CO_TRY_IMPL(QCORO_TRY_CONCAT(qcoroTryResult_, __COUNTER__), var, __VA_ARGS__)
@@ -4,8 +4,20 @@
 
 #pragma once
 
-#include <variant>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
 #include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <variant>
+#include <version>
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
 
 #include "coroutine.h"
 
@@ -18,6 +30,83 @@ class Generator;
 
 namespace detail {
 
+//! Unit of memory in which generator coroutine frames are allocated.
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) GeneratorFrameBlock {
+    std::byte data[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+};
+
+//! Function that releases a generator coroutine frame of given size.
+using GeneratorFrameDeleter = void (*)(void *frame, std::size_t size) noexcept;
+
+constexpr std::size_t alignFrameOffset(std::size_t offset, std::size_t alignment) noexcept {
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief Allocates generator coroutine frames using the allocator \c Alloc.
+ *
+ * The function that deallocates the frame is stored right after the coroutine frame,
+ * followed by a copy of the allocator, unless the allocator is stateless. This allows
+ * GeneratorPromise::operator delete() to release the frame without knowing which allocator
+ * it was allocated with.
+ **/
+template<typename Alloc>
+class GeneratorFrameAllocator {
+    using BlockAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<GeneratorFrameBlock>;
+    using Traits = std::allocator_traits<BlockAllocator>;
+    static constexpr bool isStateless =
+        std::is_empty_v<BlockAllocator> && std::is_default_constructible_v<BlockAllocator>;
+
+public:
+    static void *allocate(std::size_t size, const Alloc &alloc) {
+        BlockAllocator allocator(alloc);
+        auto *frame = reinterpret_cast<std::byte *>(Traits::allocate(allocator, blockCount(size)));
+        const GeneratorFrameDeleter deleter = &GeneratorFrameAllocator::deallocate;
+        std::memcpy(frame + deleterOffset(size), &deleter, sizeof(deleter));
+        if constexpr (!isStateless) {
+            ::new (frame + allocatorOffset(size)) BlockAllocator(std::move(allocator));
+        }
+        return frame;
+    }
+
+private:
+    static void deallocate(void *frame, std::size_t size) noexcept {
+        auto *blocks = static_cast<GeneratorFrameBlock *>(frame);
+        if constexpr (isStateless) {
+            BlockAllocator allocator;
+            Traits::deallocate(allocator, blocks, blockCount(size));
+        } else {
+            auto *stored = std::launder(
+                reinterpret_cast<BlockAllocator *>(static_cast<std::byte *>(frame) + allocatorOffset(size)));
+            BlockAllocator allocator(std::move(*stored));
+            stored->~BlockAllocator();
+            Traits::deallocate(allocator, blocks, blockCount(size));
+        }
+    }
+
+    static constexpr std::size_t deleterOffset(std::size_t size) noexcept {
+        return alignFrameOffset(size, alignof(GeneratorFrameDeleter));
+    }
+
+    static constexpr std::size_t allocatorOffset(std::size_t size) noexcept {
+        return alignFrameOffset(deleterOffset(size) + sizeof(GeneratorFrameDeleter), alignof(BlockAllocator));
+    }
+
+    static constexpr std::size_t blockCount(std::size_t size) noexcept {
+        const auto total = isStateless ? deleterOffset(size) + sizeof(GeneratorFrameDeleter)
+                                       : allocatorOffset(size) + sizeof(BlockAllocator);
+        return (total + sizeof(GeneratorFrameBlock) - 1) / sizeof(GeneratorFrameBlock);
+    }
+};
+
+//! Releases a generator coroutine frame allocated by GeneratorFrameAllocator.
+inline void releaseGeneratorFrame(void *frame, std::size_t size) noexcept {
+    GeneratorFrameDeleter deleter = nullptr;
+    std::memcpy(&deleter, static_cast<std::byte *>(frame) + alignFrameOffset(size, alignof(GeneratorFrameDeleter)),
+                sizeof(deleter));
+    deleter(frame, size);
+}
+
 /**
  * @brief Promise type for generator coroutine.
  *
@@ -26,11 +115,27 @@ namespace detail {
  *
  * The generator coroutine is suspended on start (it won't produce any value
  * until asked for).
+ *
+ * Generator coroutines that take a custom allocator use GeneratorAllocatorPromise instead.
  **/
 template<typename T>
 class GeneratorPromise {
     using value_type = std::remove_reference_t<T>;
 public:
+    /**
+     * Allocates the coroutine frame using the default allocator.
+     **/
+    static void *operator new(std::size_t size) {
+        return GeneratorFrameAllocator<std::allocator<void>>::allocate(size, {});
+    }
+
+    /**
+     * Releases the coroutine frame using the allocator it was allocated with.
+     **/
+    static void operator delete(void *frame, std::size_t size) noexcept {
+        releaseGeneratorFrame(frame, size);
+    }
+
     /**
      * Constructs the Generator<T> object returned from the generator coroutine
      * to the caller.
@@ -97,8 +202,7 @@ public:
      * Returns the current value stored in the promise type.
      **/
     value_type &value() {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-        return *const_cast<value_type *>(static_cast<const value_type *>(mValue));
+        return *mValue;
     }
 
     /**
@@ -123,10 +227,42 @@ public:
     std::suspend_never await_transform(U &&) = delete;
 
 private:
-    const void *mValue = nullptr;
+    value_type *mValue = nullptr;
     std::exception_ptr mException;
 };
 
+/**
+ * @brief Promise type for generator coroutine that allocates its frame using a custom allocator.
+ *
+ * Used if the generator coroutine takes `std::allocator_arg` as its first argument (or the first
+ * argument after the object, if the coroutine is a member function), followed by the allocator.
+ * \c AllocIndex is the index of the allocator in the coroutine's parameters \c Params.
+ * It only adds the allocation functions to GeneratorPromise, so the coroutine is still
+ * handled through its GeneratorPromise<T> base by Generator<T>.
+ *
+ * The promise is specific to the coroutine's parameter types, so that operator new() doesn't
+ * have to be a function template. GCC would otherwise report a bogus -Wmismatched-new-delete
+ * in every generator coroutine that takes an allocator.
+ **/
+template<typename T, std::size_t AllocIndex, typename... Params>
+class GeneratorAllocatorPromise : public GeneratorPromise<T> {
+    using Allocator = std::remove_cvref_t<std::tuple_element_t<AllocIndex, std::tuple<Params...>>>;
+public:
+    /**
+     * Allocates the coroutine frame using the allocator passed to the generator coroutine.
+     **/
+    static void *operator new(std::size_t size, const std::remove_reference_t<Params> &...params) {
+        return GeneratorFrameAllocator<Allocator>::allocate(size, std::get<AllocIndex>(std::tie(params...)));
+    }
+
+    /**
+     * Releases the coroutine frame using the allocator it was allocated with.
+     **/
+    static void operator delete(void *frame, std::size_t size) noexcept {
+        releaseGeneratorFrame(frame, size);
+    }
+};
+
 } // namespace detail
 
 /**
@@ -141,7 +277,8 @@ private:
  * will become invalid and will be equal to Generator<T>::end().
  *
  * The iterator can only be obtained from Generator<T>::begin() and Generator<T>::end()
- * methods.
+ * methods. It satisfies the `std::input_iterator` concept, so Generator<T> can be used
+ * with algorithms and views from the `std::ranges` library.
  */
 template<typename T>
 class GeneratorIterator {
@@ -151,9 +288,14 @@ public:
     // Not sure what type should be used for difference_type as we don't
     // allow calculating difference between two iterators.
     using difference_type = std::ptrdiff_t;
-    using value_type = std::remove_reference_t<T>;
+    using value_type = std::remove_cvref_t<T>;
     using reference = std::add_lvalue_reference_t<T>;
-    using pointer = std::add_pointer_t<value_type>;
+    using pointer = std::add_pointer_t<std::remove_reference_t<T>>;
+
+    /**
+     * @brief Constructs an invalid iterator.
+     **/
+    constexpr GeneratorIterator() noexcept = default;
 
     /**
      * @brief Constructs an invalid iterator.
@@ -168,7 +310,7 @@ public:
      *
      * If the generator coroutine throws an exception, it will be rethrown from here.
      **/
-    GeneratorIterator operator++() {
+    GeneratorIterator &operator++() {
         if (!mGeneratorCoroutine) {
             return *this;
         }
@@ -183,6 +325,16 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Resumes the generator coroutine until it yields new value or finishes.
+     *
+     * Unlike the prefix increment operator, this doesn't return anything, as the
+     * previous value is no longer available once the generator coroutine is resumed.
+     **/
+    void operator++(int) {
+        ++*this;
+    }
+
     /**
      * @brief Returns value produced by the generator coroutine.
      **/
@@ -229,9 +381,30 @@ private:
  * When the Generator<T> object is destroyed, the associated generator coroutine is
  * also destroyed, even if it has not yet finished. All values allocated on stack of
  * the generator coroutine will be destroyed automatically.
+ *
+ * Generator<T> is a move-only input range and a view, so it can be passed to
+ * algorithms and composed with views from the `std::ranges` library.
+ *
+ * The generator coroutine frame is allocated on the heap, unless the generator
+ * coroutine accepts `std::allocator_arg` followed by an allocator as its first
+ * arguments, in which case the frame is allocated using the allocator. This allows
+ * using pooled allocators or caller-supplied storage for generators created in tight
+ * loops:
+ *
+ * @code
+ * template<typename Alloc>
+ * QCoro::Generator<QStringView> tokens(std::allocator_arg_t, const Alloc &, QStringView input);
+ *
+ * std::pmr::unsynchronized_pool_resource pool;
+ * for (const auto &line : lines) {
+ *     for (const auto token : tokens(std::allocator_arg, std::pmr::polymorphic_allocator<>(&pool), line)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
  */
 template<typename T>
-class Generator {
+class [[nodiscard]] Generator {
 public:
     using promise_type = detail::GeneratorPromise<T>;
     using iterator = GeneratorIterator<T>;
@@ -309,3 +482,38 @@ QCoro::Generator<T> QCoro::detail::GeneratorPromise<T>::get_return_object() {
     using handle_type = std::coroutine_handle<typename QCoro::Generator<T>::promise_type>;
     return QCoro::Generator<T>(handle_type::from_promise(*this));
 }
+
+namespace QCoro::detail {
+
+template<typename Tag>
+concept AllocatorArgTag = std::same_as<std::remove_cvref_t<Tag>, std::allocator_arg_t>;
+
+} // namespace QCoro::detail
+
+// Generator coroutines taking std::allocator_arg followed by an allocator use GeneratorAllocatorPromise.
+#if defined(__cpp_lib_coroutine)
+namespace std {
+#else
+namespace std::experimental {
+#endif
+template<typename T, typename Tag, typename Alloc, typename... Args>
+    requires QCoro::detail::AllocatorArgTag<Tag>
+struct coroutine_traits<QCoro::Generator<T>, Tag, Alloc, Args...> {
+    using promise_type = QCoro::detail::GeneratorAllocatorPromise<T, 1, Tag, Alloc, Args...>;
+};
+
+// Member function, the first parameter is the object
+template<typename T, typename This, typename Tag, typename Alloc, typename... Args>
+    requires (QCoro::detail::AllocatorArgTag<Tag> && !QCoro::detail::AllocatorArgTag<This>)
+struct coroutine_traits<QCoro::Generator<T>, This, Tag, Alloc, Args...> {
+    using promise_type = QCoro::detail::GeneratorAllocatorPromise<T, 2, This, Tag, Alloc, Args...>;
+};
+} // namespace std
+
+#if defined(__cpp_lib_ranges)
+// Generator is move-only and owns the generator coroutine, so it's a view just like std::generator.
+namespace std::ranges {
+template<typename T>
+inline constexpr bool enable_view<QCoro::Generator<T>> = true;
+} // namespace std::ranges
+#endif
@@ -0,0 +1,369 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorocore_export.h"
+
+#include <QtGlobal>
+#include <QDebug>
+#include <QString>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(Q_CC_MSVC)
+#include <intrin.h>
+#define QCORO_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define QCORO_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+namespace QCoro {
+
+//! Statistics of a single coroutine.
+/*!
+ * Coroutines are identified by the address of the code that allocated their frame and by the size
+ * of the frame. The address points into the coroutine function and can be resolved to the name of
+ * the function with tools like \c addr2line.
+ */
+struct CoroutineStats {
+    //! Address of the code that allocated the coroutine frame.
+    const void *address = nullptr;
+    //! Size of the coroutine frame in bytes.
+    std::size_t frameSize = 0;
+    //! Number of frames allocated since the last reset.
+    quint64 created = 0;
+    //! Number of frames that are currently alive.
+    quint64 live = 0;
+    //! Highest number of frames alive at the same time since the last reset.
+    quint64 peakLive = 0;
+    //! Number of co_awaits performed by the coroutines since the last reset.
+    quint64 awaits = 0;
+    //! Number of heap allocations made while the coroutines were running since the last reset.
+    /*!
+     * Only counted when the allocations are instrumented with QCORO_INSTRUMENT_ALLOCATIONS().
+     */
+    quint64 allocations = 0;
+    //! Total size of the heap allocations made while the coroutines were running, in bytes.
+    quint64 allocatedBytes = 0;
+};
+
+//! Statistics of all instrumented coroutines.
+struct InstrumentationStats {
+    //! Number of coroutine frames that are currently alive.
+    quint64 liveFrames = 0;
+    //! Total size of the coroutine frames that are currently alive, in bytes.
+    quint64 liveFrameBytes = 0;
+    //! Highest total size of coroutine frames alive at the same time since the last reset, in bytes.
+    quint64 peakFrameBytes = 0;
+    //! Number of frames allocated since the last reset.
+    quint64 createdFrames = 0;
+    //! Number of heap allocations made since the last reset, see QCORO_INSTRUMENT_ALLOCATIONS().
+    quint64 allocations = 0;
+    //! Total size of the heap allocations made since the last reset, in bytes.
+    quint64 allocatedBytes = 0;
+    //! Statistics of the individual coroutines, sorted by the total size of their live frames.
+    std::vector<CoroutineStats> coroutines;
+};
+
+/*! \cond internal */
+
+namespace detail::instrumentation {
+
+struct CoroutineRecord {
+    CoroutineRecord(const void *address, std::size_t frameSize)
+        : address(address), frameSize(frameSize) {}
+
+    const void *const address;
+    const std::size_t frameSize;
+    std::atomic<quint64> created{0};
+    std::atomic<quint64> live{0};
+    std::atomic<quint64> peakLive{0};
+    std::atomic<quint64> awaits{0};
+    std::atomic<quint64> allocations{0};
+    std::atomic<quint64> allocatedBytes{0};
+};
+
+inline void updatePeak(std::atomic<quint64> &peak, quint64 value) noexcept {
+    auto current = peak.load(std::memory_order_relaxed);
+    while (current < value && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+//! Heap allocation counters, kept outside of the Registry so that counting an allocation never allocates.
+extern QCOROCORE_EXPORT std::atomic<quint64> totalAllocations;
+extern QCOROCORE_EXPORT std::atomic<quint64> totalAllocatedBytes;
+
+//! Statistics of all the instrumented coroutines.
+/*!
+ * The registry and the other instrumentation state are stored in QCoroCore, so that coroutines
+ * compiled into the application and into the QCoro libraries are all recorded together, even
+ * when each of them is a separate shared library.
+ */
+class Registry {
+public:
+    //! Returns the registry. It's never destroyed, since coroutine frames can outlive static destructors.
+    QCOROCORE_EXPORT static Registry &instance();
+
+    CoroutineRecord *record(const void *address, std::size_t frameSize) {
+        std::lock_guard lock(mMutex);
+        auto &record = mRecords[{address, frameSize}];
+        if (!record) {
+            record = std::make_unique<CoroutineRecord>(address, frameSize);
+        }
+        return record.get();
+    }
+
+    void frameCreated(CoroutineRecord *record) noexcept {
+        record->created.fetch_add(1, std::memory_order_relaxed);
+        updatePeak(record->peakLive, record->live.fetch_add(1, std::memory_order_relaxed) + 1);
+        mCreatedFrames.fetch_add(1, std::memory_order_relaxed);
+        mLiveFrames.fetch_add(1, std::memory_order_relaxed);
+        updatePeak(mPeakFrameBytes, mLiveFrameBytes.fetch_add(record->frameSize, std::memory_order_relaxed)
+                                        + record->frameSize);
+    }
+
+    void frameDestroyed(CoroutineRecord *record) noexcept {
+        record->live.fetch_sub(1, std::memory_order_relaxed);
+        mLiveFrames.fetch_sub(1, std::memory_order_relaxed);
+        mLiveFrameBytes.fetch_sub(record->frameSize, std::memory_order_relaxed);
+    }
+
+    InstrumentationStats stats() {
+        InstrumentationStats stats;
+        stats.liveFrames = mLiveFrames.load(std::memory_order_relaxed);
+        stats.liveFrameBytes = mLiveFrameBytes.load(std::memory_order_relaxed);
+        stats.peakFrameBytes = mPeakFrameBytes.load(std::memory_order_relaxed);
+        stats.createdFrames = mCreatedFrames.load(std::memory_order_relaxed);
+        stats.allocations = totalAllocations.load(std::memory_order_relaxed);
+        stats.allocatedBytes = totalAllocatedBytes.load(std::memory_order_relaxed);
+
+        std::lock_guard lock(mMutex);
+        stats.coroutines.reserve(mRecords.size());
+        for (const auto &[key, record] : mRecords) {
+            stats.coroutines.push_back({record->address, record->frameSize,
+                                        record->created.load(std::memory_order_relaxed),
+                                        record->live.load(std::memory_order_relaxed),
+                                        record->peakLive.load(std::memory_order_relaxed),
+                                        record->awaits.load(std::memory_order_relaxed),
+                                        record->allocations.load(std::memory_order_relaxed),
+                                        record->allocatedBytes.load(std::memory_order_relaxed)});
+        }
+        std::sort(stats.coroutines.begin(), stats.coroutines.end(), [](const auto &l, const auto &r) {
+            return l.live * l.frameSize > r.live * r.frameSize;
+        });
+        return stats;
+    }
+
+    void reset() {
+        const auto liveFrameBytes = mLiveFrameBytes.load(std::memory_order_relaxed);
+        mPeakFrameBytes.store(liveFrameBytes, std::memory_order_relaxed);
+        mCreatedFrames.store(0, std::memory_order_relaxed);
+        totalAllocations.store(0, std::memory_order_relaxed);
+        totalAllocatedBytes.store(0, std::memory_order_relaxed);
+
+        std::lock_guard lock(mMutex);
+        for (const auto &[key, record] : mRecords) {
+            record->created.store(0, std::memory_order_relaxed);
+            record->peakLive.store(record->live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            record->awaits.store(0, std::memory_order_relaxed);
+            record->allocations.store(0, std::memory_order_relaxed);
+            record->allocatedBytes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    Registry() = default;
+
+    std::mutex mMutex;
+    std::map<std::pair<const void *, std::size_t>, std::unique_ptr<CoroutineRecord>> mRecords;
+    std::atomic<quint64> mLiveFrames{0};
+    std::atomic<quint64> mLiveFrameBytes{0};
+    std::atomic<quint64> mPeakFrameBytes{0};
+    std::atomic<quint64> mCreatedFrames{0};
+};
+
+// Thread-local variables cannot be imported from a DLL on Windows, so there they are only
+// accessible through a function call.
+#ifdef Q_OS_WIN
+//! Record of the coroutine that is currently running in this thread.
+QCOROCORE_EXPORT CoroutineRecord *&currentCoroutine() noexcept;
+//! Record of the most recently allocated coroutine frame in this thread, picked up by its promise.
+QCOROCORE_EXPORT CoroutineRecord *&allocatedCoroutine() noexcept;
+#else
+extern QCOROCORE_EXPORT constinit thread_local CoroutineRecord *currentCoroutineRecord;
+extern QCOROCORE_EXPORT constinit thread_local CoroutineRecord *allocatedCoroutineRecord;
+
+//! Record of the coroutine that is currently running in this thread.
+inline CoroutineRecord *&currentCoroutine() noexcept {
+    return currentCoroutineRecord;
+}
+
+//! Record of the most recently allocated coroutine frame in this thread, picked up by its promise.
+inline CoroutineRecord *&allocatedCoroutine() noexcept {
+    return allocatedCoroutineRecord;
+}
+#endif
+
+//! Space in front of each frame that holds the pointer to its CoroutineRecord.
+constexpr std::size_t frameHeaderSize = std::max(sizeof(CoroutineRecord *), std::size_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__});
+
+inline void *allocateFrame(std::size_t size, const void *address) {
+    auto *record = Registry::instance().record(address, size);
+    auto *header = static_cast<std::byte *>(::operator new(size + frameHeaderSize));
+    *reinterpret_cast<CoroutineRecord **>(header) = record;
+    Registry::instance().frameCreated(record);
+    allocatedCoroutine() = record;
+    return header + frameHeaderSize;
+}
+
+inline void deallocateFrame(void *frame) noexcept {
+    auto *header = static_cast<std::byte *>(frame) - frameHeaderSize;
+    Registry::instance().frameDestroyed(*reinterpret_cast<CoroutineRecord **>(header));
+    ::operator delete(header);
+}
+
+//! Attributes the co_awaits and heap allocations to the coroutine while it's running.
+class CoroutineContext {
+public:
+    CoroutineContext() noexcept
+        : mRecord(std::exchange(allocatedCoroutine(), nullptr)) {}
+
+    void resumed() noexcept {
+        mOuterRecord = std::exchange(currentCoroutine(), mRecord);
+    }
+
+    void suspended() const noexcept {
+        currentCoroutine() = mOuterRecord;
+    }
+
+    //! Record of whoever resumed the coroutine, restored by suspended().
+    CoroutineRecord *outerRecord() const noexcept {
+        return mOuterRecord;
+    }
+
+    void awaited() noexcept {
+        if (mRecord) {
+            mRecord->awaits.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    CoroutineRecord *mRecord = nullptr;
+    CoroutineRecord *mOuterRecord = nullptr;
+};
+
+} // namespace detail::instrumentation
+
+/*! \endcond */
+
+//! Introspection of coroutine frames and allocations.
+/*!
+ * Coroutines are only instrumented when QCoro is built with the \c QCORO_ENABLE_INSTRUMENTATION
+ * CMake option, otherwise all the statistics are empty.
+ */
+namespace Instrumentation {
+
+//! Returns whether QCoro coroutines are instrumented in this build.
+constexpr bool isEnabled() {
+#ifdef QCORO_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+//! Returns the current statistics of all instrumented coroutines.
+inline InstrumentationStats stats() {
+    return detail::instrumentation::Registry::instance().stats();
+}
+
+//! Resets the counters, except for the counters of live frames.
+/*!
+ * Useful to measure the statistics for a single phase of the program, for example after the
+ * application has started up.
+ */
+inline void reset() {
+    detail::instrumentation::Registry::instance().reset();
+}
+
+//! Records a heap allocation made by the current thread.
+/*!
+ * The allocation is attributed to the coroutine that is currently running in the current
+ * thread, if any. Called by the global \c operator \c new installed by QCORO_INSTRUMENT_ALLOCATIONS().
+ */
+inline void recordAllocation(std::size_t size) noexcept {
+    detail::instrumentation::totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    detail::instrumentation::totalAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (auto *record = detail::instrumentation::currentCoroutine(); record != nullptr) {
+        record->allocations.fetch_add(1, std::memory_order_relaxed);
+        record->allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+//! Prints the statistics of all instrumented coroutines using qInfo().
+/*!
+ * At most \c limit coroutines with the largest total size of live frames are printed.
+ */
+inline void dump(std::size_t limit = 20) {
+    const auto stats = Instrumentation::stats();
+    qInfo().noquote() << QString::asprintf(
+        "QCoro: %llu live frames (%llu bytes, peak %llu bytes), %llu frames created, %llu allocations (%llu bytes)",
+        static_cast<unsigned long long>(stats.liveFrames), static_cast<unsigned long long>(stats.liveFrameBytes),
+        static_cast<unsigned long long>(stats.peakFrameBytes), static_cast<unsigned long long>(stats.createdFrames),
+        static_cast<unsigned long long>(stats.allocations), static_cast<unsigned long long>(stats.allocatedBytes));
+    qInfo().noquote() << QStringLiteral("%1 %2 %3 %4 %5 %6 %7")
+                             .arg(QStringLiteral("address"), -18)
+                             .arg(QStringLiteral("frame size"), 10)
+                             .arg(QStringLiteral("live"), 10)
+                             .arg(QStringLiteral("peak live"), 10)
+                             .arg(QStringLiteral("created"), 10)
+                             .arg(QStringLiteral("awaits"), 10)
+                             .arg(QStringLiteral("allocs/await"), 12);
+    for (std::size_t i = 0; i < std::min(limit, stats.coroutines.size()); ++i) {
+        const auto &coroutine = stats.coroutines[i];
+        const double allocationsPerAwait =
+            coroutine.awaits > 0 ? static_cast<double>(coroutine.allocations) / coroutine.awaits : 0.0;
+        qInfo().noquote() << QStringLiteral("%1 %2 %3 %4 %5 %6 %7")
+                                 .arg(QStringLiteral("0x%1").arg(reinterpret_cast<quintptr>(coroutine.address), 0, 16), -18)
+                                 .arg(static_cast<qulonglong>(coroutine.frameSize), 10)
+                                 .arg(coroutine.live, 10)
+                                 .arg(coroutine.peakLive, 10)
+                                 .arg(coroutine.created, 10)
+                                 .arg(coroutine.awaits, 10)
+                                 .arg(allocationsPerAwait, 12, 'f', 2);
+    }
+}
+
+} // namespace Instrumentation
+
+} // namespace QCoro
+
+//! Replaces the global \c operator \c new and \c operator \c delete to count heap allocations.
+/*!
+ * Must be used exactly once in the program, outside of any namespace. The allocations are
+ * attributed to the coroutine that was running when the allocation was made.
+ */
+#define QCORO_INSTRUMENT_ALLOCATIONS()                                                             \
+    void *operator new(std::size_t size) {                                                         \
+        QCoro::Instrumentation::recordAllocation(size);                                            \
+        if (void *ptr = std::malloc(size == 0 ? 1 : size)) {                                       \
+            return ptr;                                                                            \
+        }                                                                                          \
+        throw std::bad_alloc();                                                                    \
+    }                                                                                              \
+    void operator delete(void *ptr) noexcept {                                                     \
+        std::free(ptr);                                                                            \
+    }                                                                                              \
+    void operator delete(void *ptr, std::size_t) noexcept {                                        \
+        std::free(ptr);                                                                            \
+    }
@@ -25,11 +25,13 @@ template<typename T>
 class LazyTaskPromise : public TaskPromise<T>
 {
 public:
-    using TaskPromise<T>::TaskPromise;
+    //! \copydoc TaskPromise<T>::TaskPromise()
+    explicit LazyTaskPromise(registry::Location location = registry::Location::current())
+        : TaskPromise<T>(location) {}
 
     LazyTask<T> get_return_object() noexcept;
 
-    std::suspend_always initial_suspend() const noexcept;
+    TaskInitialSuspend initial_suspend() noexcept;
 };
 
 } // namespace detail
@@ -0,0 +1,407 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcoroasyncgenerator.h"
+#include "qcoroasyncgeneratoroperators.h"
+#include "qcorotask.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <list>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace QCoro {
+
+//! Determines what happens when a subscriber of a SharedAsyncGenerator falls behind.
+enum class SlowConsumerPolicy {
+    //! The source generator is not resumed until the slowest subscriber catches up.
+    Block,
+    //! The slowest subscribers skip the oldest values to keep up with the others.
+    DropOldest
+};
+
+/*! \cond internal */
+
+namespace detail {
+
+//! Buffer of values broadcast from a single source generator to multiple subscribers.
+/*!
+ * Each value is stored only once. Every subscriber has a cursor pointing to the next value
+ * it will read, values are discarded once all the subscribers have moved past them. The source
+ * generator is only resumed when some subscriber is waiting for a new value and, with the
+ * SlowConsumerPolicy::Block policy, when the slowest subscriber is less than \c capacity
+ * values behind.
+ *
+ * All the coroutines involved must live in the same thread.
+ */
+template<typename V>
+class AsyncGeneratorBroadcast {
+public:
+    struct Subscriber {
+        std::uint64_t next = 0;
+        std::optional<std::uint64_t> held;
+        std::coroutine_handle<> waiting;
+        std::uint64_t waitingSince = 0;
+    };
+
+    AsyncGeneratorBroadcast(std::size_t capacity, SlowConsumerPolicy policy)
+        : mCapacity(capacity), mPolicy(policy) {}
+    Q_DISABLE_COPY(AsyncGeneratorBroadcast)
+
+    //! Registers a new subscriber, it will receive all values produced from now on.
+    Subscriber *subscribe() {
+        auto &subscriber = mSubscribers.emplace_back();
+        subscriber.next = head();
+        return &subscriber;
+    }
+
+    void unsubscribe(Subscriber *subscriber) {
+        mSubscribers.remove_if([subscriber](const Subscriber &s) { return &s == subscriber; });
+        trim();
+        resumeProducer();
+    }
+
+    //! Awaitable that suspends the subscriber until a new value is available.
+    auto waitForValue(Subscriber *subscriber) noexcept {
+        struct Awaiter {
+            AsyncGeneratorBroadcast &broadcast;
+            Subscriber *subscriber;
+
+            bool await_ready() const noexcept {
+                return broadcast.hasValue(subscriber) || broadcast.isFinished();
+            }
+            void await_suspend(std::coroutine_handle<> awaiter) {
+                subscriber->waiting = awaiter;
+                subscriber->waitingSince = broadcast.mEpoch;
+                broadcast.resumeProducer();
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this, subscriber};
+    }
+
+    bool hasValue(const Subscriber *subscriber) const noexcept {
+        return subscriber->next < head();
+    }
+
+    //! Returns the next value for the \c subscriber and keeps it alive until release() is called.
+    const V &hold(Subscriber *subscriber) {
+        const auto seq = subscriber->next++;
+        subscriber->held = seq;
+        return mItems[seq - mBase];
+    }
+
+    void release(Subscriber *subscriber) {
+        subscriber->held.reset();
+        trim();
+        resumeProducer();
+    }
+
+    //! Awaitable that suspends the producer until a subscriber asks for a new value.
+    auto waitForDemand() noexcept {
+        struct Awaiter {
+            AsyncGeneratorBroadcast &broadcast;
+
+            bool await_ready() const noexcept {
+                return broadcast.mClosed || broadcast.hasDemand();
+            }
+            void await_suspend(std::coroutine_handle<> producer) noexcept {
+                broadcast.mProducer = producer;
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    void push(V &&value) {
+        mItems.push_back(std::move(value));
+        if (mPolicy == SlowConsumerPolicy::DropOldest) {
+            const auto oldest = head() > mCapacity ? head() - mCapacity : 0;
+            for (auto &subscriber : mSubscribers) {
+                subscriber.next = std::max(subscriber.next, oldest);
+            }
+            trim();
+        }
+        resumeSubscribers();
+    }
+
+    //! Called by the producer when the source generator is exhausted.
+    void finish(std::exception_ptr exception) {
+        mFinished = true;
+        mException = std::move(exception);
+        resumeSubscribers();
+    }
+
+    //! Called when there are no more subscribers and nobody can subscribe anymore.
+    void close() {
+        mClosed = true;
+        resumeProducer();
+    }
+
+    void rethrowIfException() const {
+        if (mException) {
+            std::rethrow_exception(mException);
+        }
+    }
+
+    bool isClosed() const noexcept {
+        return mClosed;
+    }
+    bool isFinished() const noexcept {
+        return mFinished;
+    }
+
+private:
+    std::uint64_t head() const noexcept {
+        return mBase + mItems.size();
+    }
+
+    bool hasDemand() const noexcept {
+        bool waiting = false;
+        std::uint64_t slowest = head();
+        for (const auto &subscriber : mSubscribers) {
+            waiting |= static_cast<bool>(subscriber.waiting);
+            slowest = std::min(slowest, subscriber.next);
+        }
+        return waiting && (mPolicy == SlowConsumerPolicy::DropOldest || head() - slowest < mCapacity);
+    }
+
+    //! Discards values that have been read by all the subscribers.
+    void trim() {
+        std::uint64_t base = head();
+        for (const auto &subscriber : mSubscribers) {
+            base = std::min(base, subscriber.held.value_or(subscriber.next));
+        }
+        while (mBase < base) {
+            mItems.pop_front();
+            ++mBase;
+        }
+    }
+
+    void resumeProducer() {
+        if (mProducer && (mClosed || hasDemand())) {
+            std::exchange(mProducer, nullptr).resume();
+        }
+    }
+
+    void resumeSubscribers() {
+        // Resumed subscribers may unsubscribe or start waiting again, so we look up the next
+        // subscriber to resume after each resumption and skip those that started waiting
+        // only after we've started.
+        const auto epoch = ++mEpoch;
+        while (true) {
+            auto subscriber = std::find_if(mSubscribers.begin(), mSubscribers.end(), [epoch](const Subscriber &s) {
+                return s.waiting && s.waitingSince < epoch;
+            });
+            if (subscriber == mSubscribers.end()) {
+                break;
+            }
+            std::exchange(subscriber->waiting, nullptr).resume();
+        }
+    }
+
+    std::deque<V> mItems;
+    std::list<Subscriber> mSubscribers;
+    std::coroutine_handle<> mProducer;
+    std::exception_ptr mException;
+    std::uint64_t mBase = 0;
+    std::uint64_t mEpoch = 0;
+    std::size_t mCapacity;
+    SlowConsumerPolicy mPolicy;
+    bool mFinished = false;
+    bool mClosed = false;
+};
+
+//! Producer coroutine that moves values from \c source into the \c broadcast on demand.
+template<typename T>
+Task<> broadcastFrom(AsyncGenerator<T> source,
+                     std::shared_ptr<AsyncGeneratorBroadcast<async_generator_value_t<T>>> broadcast) {
+    std::exception_ptr exception;
+    try {
+        co_await broadcast->waitForDemand();
+        if (!broadcast->isClosed()) {
+            auto it = co_await source.begin();
+            while (it != source.end()) {
+                broadcast->push(takeValue(it));
+                co_await broadcast->waitForDemand();
+                if (broadcast->isClosed()) {
+                    break;
+                }
+                co_await ++it;
+            }
+        }
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    broadcast->finish(std::move(exception));
+}
+
+//! Closes the broadcast when the last SharedAsyncGenerator and subscriber are destroyed.
+template<typename V>
+class AsyncGeneratorBroadcastOwner {
+public:
+    explicit AsyncGeneratorBroadcastOwner(std::shared_ptr<AsyncGeneratorBroadcast<V>> broadcast)
+        : mBroadcast(std::move(broadcast)) {}
+    Q_DISABLE_COPY(AsyncGeneratorBroadcastOwner)
+    ~AsyncGeneratorBroadcastOwner() {
+        mBroadcast->close();
+    }
+
+    AsyncGeneratorBroadcast<V> &broadcast() const {
+        return *mBroadcast;
+    }
+
+private:
+    std::shared_ptr<AsyncGeneratorBroadcast<V>> mBroadcast;
+};
+
+//! RAII handle unregistering the subscriber when the subscriber generator is destroyed.
+/*!
+ * The subscription is passed into the subscriber coroutine as an argument, so that it's
+ * cleaned up even if the subscriber generator is destroyed without ever being started.
+ */
+template<typename V>
+class AsyncGeneratorSubscription {
+public:
+    using Subscriber = typename AsyncGeneratorBroadcast<V>::Subscriber;
+
+    explicit AsyncGeneratorSubscription(std::shared_ptr<AsyncGeneratorBroadcastOwner<V>> owner)
+        : mOwner(std::move(owner)), mSubscriber(mOwner->broadcast().subscribe()) {}
+    AsyncGeneratorSubscription(AsyncGeneratorSubscription &&other) noexcept
+        : mOwner(std::move(other.mOwner)), mSubscriber(std::exchange(other.mSubscriber, nullptr)) {}
+    AsyncGeneratorSubscription &operator=(AsyncGeneratorSubscription &&) = delete;
+    Q_DISABLE_COPY(AsyncGeneratorSubscription)
+    ~AsyncGeneratorSubscription() {
+        if (mSubscriber) {
+            mOwner->broadcast().unsubscribe(mSubscriber);
+        }
+    }
+
+    AsyncGeneratorBroadcast<V> &broadcast() const {
+        return mOwner->broadcast();
+    }
+    Subscriber *subscriber() const {
+        return mSubscriber;
+    }
+
+private:
+    std::shared_ptr<AsyncGeneratorBroadcastOwner<V>> mOwner;
+    Subscriber *mSubscriber;
+};
+
+template<typename V>
+AsyncGenerator<const V &> subscriberGenerator(AsyncGeneratorSubscription<V> subscription) {
+    auto &broadcast = subscription.broadcast();
+    auto *subscriber = subscription.subscriber();
+    while (true) {
+        while (!broadcast.hasValue(subscriber) && !broadcast.isFinished()) {
+            co_await broadcast.waitForValue(subscriber);
+        }
+        if (!broadcast.hasValue(subscriber)) {
+            broadcast.rethrowIfException();
+            break;
+        }
+
+        co_yield broadcast.hold(subscriber);
+        broadcast.release(subscriber);
+    }
+}
+
+class ShareOperator : public GeneratorOperator {
+public:
+    ShareOperator(std::size_t capacity, SlowConsumerPolicy policy)
+        : mCapacity(capacity), mPolicy(policy) {}
+
+    template<typename T>
+    auto operator()(AsyncGenerator<T> &&source) const;
+
+private:
+    std::size_t mCapacity;
+    SlowConsumerPolicy mPolicy;
+};
+
+} // namespace detail
+
+/*! \endcond */
+
+//! A generator whose values are broadcast to multiple subscribers.
+/*!
+ * SharedAsyncGenerator is created from an AsyncGenerator<T> using QCoro::share(). Each call
+ * to subscribe() returns a new AsyncGenerator that produces all the values produced by the
+ * source generator from that moment on. The values are stored only once in a buffer shared
+ * by all the subscribers, which receive a const reference to them.
+ *
+ * The source generator is resumed whenever any subscriber asks for a new value. How far can
+ * the slowest subscriber fall behind is limited by the capacity of the buffer; what happens
+ * when it's reached is determined by the SlowConsumerPolicy.
+ *
+ * The source generator is destroyed once the SharedAsyncGenerator and all the subscriber
+ * generators are destroyed. All subscribers must live in the same thread.
+ *
+ * @code
+ * auto frames = QCoro::share(qCoroSignalListener(socket, &QWebSocket::binaryMessageReceived));
+ * logFrames(frames.subscribe());
+ * processFrames(frames.subscribe());
+ * @endcode
+ */
+template<typename T>
+class SharedAsyncGenerator {
+public:
+    //! Type of values produced by the source generator.
+    using value_type = detail::async_generator_value_t<T>;
+    //! Type of generator returned by subscribe().
+    using generator_type = AsyncGenerator<const value_type &>;
+
+    //! Creates a new shared generator consuming values from the \c source generator.
+    explicit SharedAsyncGenerator(AsyncGenerator<T> &&source, std::size_t capacity = 16,
+                                  SlowConsumerPolicy policy = SlowConsumerPolicy::Block) {
+        Q_ASSERT(capacity > 0);
+        auto broadcast = std::make_shared<detail::AsyncGeneratorBroadcast<value_type>>(capacity, policy);
+        mOwner = std::make_shared<detail::AsyncGeneratorBroadcastOwner<value_type>>(broadcast);
+        detail::broadcastFrom(std::move(source), std::move(broadcast));
+    }
+
+    //! Returns a new generator producing all values produced from now on.
+    /*!
+     * Note that the subscriber is registered immediately, not when the returned generator is
+     * started. With the SlowConsumerPolicy::Block policy, a subscriber which is not being
+     * iterated prevents other subscribers from progressing once the buffer is full.
+     */
+    generator_type subscribe() const {
+        return detail::subscriberGenerator(detail::AsyncGeneratorSubscription<value_type>(mOwner));
+    }
+
+private:
+    std::shared_ptr<detail::AsyncGeneratorBroadcastOwner<value_type>> mOwner;
+};
+
+//! Turns the \c source generator into a SharedAsyncGenerator.
+/*!
+ * \param capacity Maximum number of values the slowest subscriber can fall behind.
+ * \param policy What happens when the slowest subscriber falls behind by \c capacity values.
+ */
+template<typename T>
+SharedAsyncGenerator<T> share(AsyncGenerator<T> &&source, std::size_t capacity = 16,
+                              SlowConsumerPolicy policy = SlowConsumerPolicy::Block) {
+    return SharedAsyncGenerator<T>(std::move(source), capacity, policy);
+}
+
+//! \copydoc share(AsyncGenerator<T> &&source, std::size_t capacity, SlowConsumerPolicy policy)
+inline auto share(std::size_t capacity = 16, SlowConsumerPolicy policy = SlowConsumerPolicy::Block) {
+    return detail::ShareOperator{capacity, policy};
+}
+
+template<typename T>
+auto detail::ShareOperator::operator()(AsyncGenerator<T> &&source) const {
+    return SharedAsyncGenerator<T>(std::move(source), mCapacity, mPolicy);
+}
+
+} // namespace QCoro
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorotask.h"
+
+#include <type_traits>
+
+namespace QCoro {
+
+template<typename T>
+class SharedTask;
+
+/*! \cond internal */
+
+namespace detail {
+
+//! Specialization of QCoro::detail::isTask for SharedTask.
+template<typename T>
+struct isTask<QCoro::SharedTask<T>> : std::true_type {
+    using return_type = typename QCoro::SharedTask<T>::value_type;
+};
+
+template<typename T>
+class SharedTaskPromise : public TaskPromise<T> {
+public:
+    //! \copydoc TaskPromise<T>::TaskPromise()
+    explicit SharedTaskPromise(registry::Location location = registry::Location::current())
+        : TaskPromise<T>(location) {}
+
+    SharedTask<T> get_return_object() noexcept;
+};
+
+//! Type of the result of co_awaiting an lvalue SharedTask<T>.
+/*!
+ * Small trivially copyable results are returned by value, everything else by a const reference
+ * to the result stored in the coroutine. Co_awaiting a temporary SharedTask<T> always returns
+ * the result by value.
+ */
+template<typename T>
+struct SharedTaskResultType {
+    using type = std::conditional_t<std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void *), T, const T &>;
+};
+
+template<>
+struct SharedTaskResultType<void> {
+    using type = void;
+};
+
+template<typename T>
+using SharedTaskResult = typename SharedTaskResultType<T>::type;
+
+} // namespace detail
+
+/*! \endcond */
+
+//! An eager coroutine whose result can be co_awaited by any number of coroutines.
+/*!
+ * ```cpp
+ * QCoro::SharedTask<QImage> ThumbnailCache::thumbnail(const QString &path) {
+ *     auto it = mPending.find(path);
+ *     if (it == mPending.end()) {
+ *         // Only the first request starts loading the thumbnail
+ *         it = mPending.emplace(path, loadThumbnail(path)).first;
+ *     }
+ *     return it->second;
+ * }
+ * ```
+ *
+ * Unlike Task<T>, the SharedTask<T> can be copied. All copies refer to the same coroutine, and every
+ * coroutine co_awaiting any of the copies is resumed once the coroutine finishes. The result is kept
+ * in the coroutine until the last copy of the SharedTask is destroyed, and each awaiter gets a const
+ * reference to it, or a copy if the result is small and trivially copyable. An exception thrown by
+ * the coroutine is re-thrown to every awaiter.
+ *
+ * \warning The reference is only valid as long as a copy of the SharedTask exists. Co_awaiting
+ * a temporary SharedTask, e.g. `co_await thumbnail(path)`, therefore returns a copy of the result
+ * instead, so that `const auto &image = co_await thumbnail(path);` doesn't dangle.
+ */
+template<typename T = void>
+class SharedTask final : public detail::TaskBase<T, SharedTask, detail::SharedTaskPromise<T>> {
+public:
+    using promise_type = detail::SharedTaskPromise<T>;
+    using value_type = T;
+
+    using detail::TaskBase<T, SharedTask, promise_type>::TaskBase;
+
+    //! Creates another reference to the same coroutine.
+    SharedTask(const SharedTask &other) noexcept;
+    //! \copydoc SharedTask(const SharedTask &)
+    SharedTask &operator=(const SharedTask &other) noexcept;
+    SharedTask(SharedTask &&other) noexcept = default;
+    SharedTask &operator=(SharedTask &&other) noexcept = default;
+    ~SharedTask() override = default;
+
+    //! Returns a const reference to the result, or a copy of it if it's small and trivially copyable.
+    auto operator co_await() const & noexcept;
+    //! Returns a copy of the result, since the temporary may hold the last reference to the coroutine.
+    auto operator co_await() const && noexcept;
+
+private:
+    template<typename Result>
+    auto awaiter() const noexcept;
+};
+
+//! Wraps the \c awaitable into a SharedTask, so that its result can be co_awaited multiple times.
+/*!
+ * The \c awaitable is co_awaited immediately.
+ */
+template<typename Awaitable>
+requires detail::TaskConvertible<Awaitable>
+auto toSharedTask(Awaitable awaitable) -> SharedTask<detail::convertible_awaitable_return_type_t<Awaitable>>;
+
+} // namespace QCoro
+
+#include "impl/sharedtask.h"
@@ -7,6 +7,21 @@
 #include "coroutine.h"
 #include "concepts_p.h"
 #include "mixins_p.h"
+#include "qcorodeadline.h"
+#include "qcorotracing.h"
+#ifdef QCORO_INSTRUMENTATION
+#include "qcoroinstrumentation.h"
+#endif
+#ifdef QCORO_COROUTINE_REGISTRY
+#include "qcorocoroutineregistry.h"
+#else
+namespace QCoro::detail::registry {
+//! Stands in for std::source_location when the coroutine registry is disabled.
+struct Location {
+    static constexpr Location current() noexcept { return {}; }
+};
+} // namespace QCoro::detail::registry
+#endif
 
 #include <atomic>
 #include <exception>
@@ -67,6 +82,27 @@ private:
     std::vector<std::coroutine_handle<>> mAwaitingCoroutines;
 };
 
+class TaskPromiseBase;
+
+//! Awaitable returned from initial_suspend(), lets the promise know when the coroutine starts running.
+class TaskInitialSuspend {
+public:
+    //! Constructs the awaitable for the coroutine of the \c promise.
+    /*!
+     * \param[in] suspend whether the coroutine should be suspended until resumed explicitly
+     */
+    explicit TaskInitialSuspend(TaskPromiseBase &promise, bool suspend);
+
+    bool await_ready() const noexcept;
+    constexpr void await_suspend(std::coroutine_handle<>) const noexcept;
+    //! Called when the coroutine starts running, which may be right away.
+    void await_resume() const noexcept;
+
+private:
+    TaskPromiseBase &mPromise;
+    bool mSuspend;
+};
+
 //! Base class for the \c Task<T> promise_type.
 /*!
  * This is a promise_type for a Task<T> returned from a coroutine. When a coroutine
@@ -115,7 +151,7 @@ public:
      * it as a regular function, therefore it returns `std::suspend_never` awaitable, which
      * indicates that the coroutine should not be suspended.
      * */
-    std::suspend_never initial_suspend() const noexcept;
+    TaskInitialSuspend initial_suspend() noexcept;
 
     //! Called when the coroutine co_returns or reaches the end of user code.
     /*!
@@ -123,6 +159,59 @@ public:
      */
     auto final_suspend() const noexcept;
 
+    //! Wraps the Awaitable to propagate the context of this coroutine.
+    /*!
+     * See AwaitTransformMixin::await_transform() for how the Awaitable is obtained. The returned
+     * Awaitable calls resumed() and suspending() so that e.g. the deadline of this coroutine is
+     * the current deadline for the thread whenever the coroutine runs.
+     */
+    template<typename T>
+    requires requires(AwaitTransformMixin &mixin, T &&value) { mixin.await_transform(std::forward<T>(value)); }
+    auto await_transform(T &&value, registry::Location location = registry::Location::current());
+
+    //! Sets the deadline of this coroutine, see QCoro::setDeadline().
+    std::suspend_never await_transform(DeadlineRequest request) noexcept;
+
+    //! Called whenever the coroutine starts or resumes running.
+    void resumed() noexcept;
+    //! Called whenever the coroutine suspends or finishes.
+    void suspended() const noexcept;
+
+    //! Restores the context of whoever resumed the coroutine when destroyed, see suspending().
+    class SuspendScope {
+    public:
+        explicit SuspendScope(const TaskPromiseBase &promise) noexcept;
+        ~SuspendScope();
+        SuspendScope(const SuspendScope &) = delete;
+        SuspendScope &operator=(const SuspendScope &) = delete;
+
+    private:
+        DeadlineClock::time_point mOuterDeadline;
+#ifdef QCORO_INSTRUMENTATION
+        instrumentation::CoroutineRecord *mOuterRecord;
+#endif
+    };
+
+    //! Called when the coroutine is about to suspend in a co_await.
+    /*!
+     * Unlike suspended(), the context of whoever resumed the coroutine is only restored once
+     * the returned scope is destroyed, so that e.g. allocations made by the awaiter while
+     * suspending the coroutine are still attributed to it. The scope doesn't reference the
+     * promise, so it may outlive the suspension (or the whole coroutine).
+     */
+    [[nodiscard]] SuspendScope suspending() const noexcept;
+
+#ifdef QCORO_COROUTINE_REGISTRY
+    //! Records the address of the coroutine frame in QCoro::CoroutineRegistry.
+    void setFrame(const void *frame) noexcept;
+#endif
+
+#ifdef QCORO_INSTRUMENTATION
+    //! Allocates the coroutine frame and records it in QCoro::Instrumentation.
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr) noexcept;
+#endif
+
     //! Called by \c TaskAwaiter when co_awaited.
     /*!
      * This function is called by a TaskAwaiter, e.g. an object obtain by co_await
@@ -142,7 +231,7 @@ public:
     void destroyCoroutine();
 
 protected:
-    explicit TaskPromiseBase();
+    explicit TaskPromiseBase(registry::Location location);
 
 private:
     friend class TaskFinalSuspend;
@@ -152,6 +241,17 @@ private:
 
     //! Indicates whether we can destroy the coroutine handle
     std::atomic<uint32_t> mRefCount{0};
+
+    //! Deadline of this coroutine
+    DeadlineContext mDeadlineContext;
+#ifdef QCORO_INSTRUMENTATION
+    //! Instrumentation record of this coroutine
+    instrumentation::CoroutineContext mInstrumentationContext;
+#endif
+#ifdef QCORO_COROUTINE_REGISTRY
+    //! Entry of this coroutine in the QCoro::CoroutineRegistry
+    mutable registry::CoroutineEntry mRegistryEntry;
+#endif
 };
 
 //! The promise_type for Task<T>
@@ -161,7 +261,9 @@ private:
 template<typename T>
 class TaskPromise: public TaskPromiseBase {
 public:
-    explicit TaskPromise() = default;
+    //! The \c location is the location of the coroutine, it's filled in by the compiler.
+    explicit TaskPromise(registry::Location location = registry::Location::current())
+        : TaskPromiseBase(location) {}
     ~TaskPromise() = default;
 
     //! Constructs a Task<T> for this promise.
@@ -208,7 +310,9 @@ template<>
 class TaskPromise<void>: public TaskPromiseBase {
 public:
     // Constructor.
-    explicit TaskPromise() = default;
+    //! The \c location is the location of the coroutine, it's filled in by the compiler.
+    explicit TaskPromise(registry::Location location = registry::Location::current())
+        : TaskPromiseBase(location) {}
 
     //! Destructor.
     ~TaskPromise() = default;
@@ -285,6 +389,9 @@ protected:
 
     //! Handle of the coroutine that is being co_awaited by this awaiter
     std::coroutine_handle<Promise> mAwaitedCoroutine = {};
+
+    //! Reports the suspension of the co_awaiting coroutine to QCoro::Tracing
+    QCORO_NO_UNIQUE_ADDRESS tracing::SuspensionTrace mTrace;
 };
 
 template<typename T>
@@ -468,25 +575,41 @@ using convertible_awaitable_return_type_t = typename detail::awaitable_return_ty
 
 } // namespace detail
 
+//! Specifies how QCoro::waitFor() waits for the coroutine to finish.
+enum class WaitMode {
+    //! Runs a nested QEventLoop until the coroutine finishes.
+    EventLoop,
+    //! Blocks the calling thread without processing any events until the coroutine finishes.
+    /*!
+     * This is only usable when the coroutine is resumed in a different thread than the one
+     * calling waitFor(), otherwise the coroutine will never be resumed and waitFor() will
+     * block forever.
+     */
+    Blocking,
+};
+
 //! Waits for a coroutine to complete in a blocking manner.
 /*!
  * Sometimes you may need to wait for a coroutine to finish  without co_awaiting it - that is,
  * you want to wait for the coroutine in a blocking mode. This function does exactly that.
- * The function creates a nested QEventLoop and executes it until the coroutine has finished.
+ * By default the function creates a nested QEventLoop and executes it until the coroutine
+ * has finished. With WaitMode::Blocking the calling thread is blocked on a wait condition
+ * instead.
  *
  * \param task Coroutine to blockingly wait for.
+ * \param mode How to wait for the coroutine to finish.
  * \returns Result of the coroutine.
  */
 template<typename T>
-inline T waitFor(QCoro::Task<T> &task);
+inline T waitFor(QCoro::Task<T> &task, WaitMode mode = WaitMode::EventLoop);
 
 // \overload
 template<typename T>
-inline T waitFor(QCoro::Task<T> &&task);
+inline T waitFor(QCoro::Task<T> &&task, WaitMode mode = WaitMode::EventLoop);
 
 // \overload
 template<Awaitable Awaitable>
-inline auto waitFor(Awaitable &&awaitable);
+inline auto waitFor(Awaitable &&awaitable, WaitMode mode = WaitMode::EventLoop);
 
 //! Connect a callback to be called when the asynchronous task finishes.
 /*!
@@ -512,6 +635,7 @@ void connect(T &&future, QObjectSubclass *context, Callback func);
 
 } // namespace QCoro
 
+#include "impl/taskinitialsuspend.h"
 #include "impl/taskfinalsuspend.h"
 #include "impl/taskpromisebase.h"
 #include "impl/taskpromise.h"
@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "coroutine.h"
+#include "macros_p.h"
+#include "qcorocore_export.h"
+
+#include <QtGlobal>
+#include <QThread>
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+namespace QCoro {
+
+namespace Tracing {
+
+//! The kind of operation a coroutine is suspended on.
+enum class SuspensionKind {
+    //! Awaiting a \c QCoro::Task or \c QCoro::LazyTask.
+    Task,
+    //! Awaiting a Qt signal.
+    Signal,
+    //! Awaiting an I/O operation: a \c QIODevice (including sockets, processes and network replies)
+    //! or a server accepting new connections.
+    IODevice,
+    //! Moving to another thread with \c QCoro::moveToThread().
+    Thread,
+    //! Sleeping with \c QCoro::sleepFor() or \c QCoro::sleepUntil(), or awaiting a \c QTimer.
+    Timer,
+    //! Waiting in the event queue to be resumed once the awaited operation has completed.
+    /*!
+     * Some operations don't resume the coroutine directly, but post its resumption to the event loop.
+     * The time until the event loop gets to it is reported as a separate suspension, nested within
+     * the suspension on the operation itself.
+     */
+    Queued,
+};
+
+//! Number of values of \c SuspensionKind.
+inline constexpr int suspensionKindCount = 6;
+
+//! Returns a human-readable name of the \c kind.
+constexpr const char *suspensionKindName(SuspensionKind kind) noexcept {
+    switch (kind) {
+    case SuspensionKind::Task:
+        return "Task";
+    case SuspensionKind::Signal:
+        return "Signal";
+    case SuspensionKind::IODevice:
+        return "IODevice";
+    case SuspensionKind::Thread:
+        return "Thread";
+    case SuspensionKind::Timer:
+        return "Timer";
+    case SuspensionKind::Queued:
+        return "Queued";
+    }
+    return "Unknown";
+}
+
+//! Describes a single suspension of a coroutine.
+struct SuspensionEvent {
+    //! What the coroutine is suspended on.
+    SuspensionKind kind = SuspensionKind::Task;
+    //! Address of the frame of the suspended coroutine.
+    const void *coroutine = nullptr;
+    //! The thread in which the coroutine has suspended.
+    Qt::HANDLE thread = nullptr;
+    //! When the coroutine has suspended.
+    std::chrono::steady_clock::time_point suspendedAt;
+};
+
+} // namespace Tracing
+
+//! Receives a notification whenever a coroutine suspends and resumes at a QCoro suspension point.
+/*!
+ * The tracer is invoked from whichever thread the coroutine suspends or resumes in, possibly from
+ * multiple threads at the same time, so the implementation must be thread-safe. It should also be
+ * fast, as it's invoked on every suspension.
+ *
+ * See QCoro::Tracing::setTracer().
+ */
+class Tracer {
+public:
+    virtual ~Tracer() = default;
+
+    //! Called when a coroutine suspends.
+    virtual void suspended(const Tracing::SuspensionEvent &event) noexcept = 0;
+
+    //! Called when the coroutine described by the \c event resumes.
+    /*!
+     * The \c event is the same event that has been passed to suspended().
+     */
+    virtual void resumed(const Tracing::SuspensionEvent &event,
+                         std::chrono::steady_clock::time_point resumedAt) noexcept = 0;
+};
+
+/*! \cond internal */
+
+namespace detail::tracing {
+
+//! The installed tracer, shared by the application and all the QCoro libraries.
+extern QCOROCORE_EXPORT std::atomic<Tracer *> currentTracer;
+
+//! Marks a helper QObject whose signals report the progress of an I/O operation.
+/*!
+ * Waiting for a signal of such object is traced as Tracing::SuspensionKind::IODevice
+ * rather than Tracing::SuspensionKind::Signal.
+ */
+struct IOSignalSource {};
+
+#ifdef QCORO_TRACING
+
+//! Reports a single suspension of a coroutine to the current tracer, if there's any.
+/*!
+ * Awaiters hold this as a QCORO_NO_UNIQUE_ADDRESS member, call suspended() from await_suspend()
+ * and resumed() from await_resume(). Without QCORO_TRACING the class is empty, so it doesn't make
+ * the awaiters any larger.
+ */
+class SuspensionTrace {
+public:
+    void suspended(Tracing::SuspensionKind kind, std::coroutine_handle<> coroutine) noexcept {
+        mTracer = currentTracer.load(std::memory_order_acquire);
+        if (mTracer != nullptr) [[unlikely]] {
+            mEvent = {kind, coroutine.address(), QThread::currentThreadId(), std::chrono::steady_clock::now()};
+            mTracer->suspended(mEvent);
+        }
+    }
+
+    void resumed() noexcept {
+        auto *tracer = std::exchange(mTracer, nullptr);
+        // Don't report to a tracer that has been uninstalled in the meantime, it may be gone.
+        if (tracer != nullptr && tracer == currentTracer.load(std::memory_order_acquire)) [[unlikely]] {
+            tracer->resumed(mEvent, std::chrono::steady_clock::now());
+        }
+    }
+
+private:
+    Tracer *mTracer = nullptr;
+    Tracing::SuspensionEvent mEvent;
+};
+
+#else
+
+class SuspensionTrace {
+public:
+    void suspended(Tracing::SuspensionKind, std::coroutine_handle<>) noexcept {}
+    void resumed() noexcept {}
+};
+
+#endif
+
+} // namespace detail::tracing
+
+/*! \endcond */
+
+//! Tracing of coroutine suspensions.
+/*!
+ * The suspension points are only traced when QCoro is built with the \c QCORO_ENABLE_TRACING
+ * CMake option, otherwise the tracer is never invoked.
+ */
+namespace Tracing {
+
+//! Returns whether the QCoro suspension points are traced in this build.
+constexpr bool isEnabled() {
+#ifdef QCORO_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+//! Installs the \c tracer, replacing the current one. Pass \c nullptr to stop tracing.
+/*!
+ * The tracer is not owned by QCoro. Coroutines that have suspended before the tracer has been
+ * replaced don't report their resumption to it, but a call to the tracer may still be in progress
+ * in another thread when this function returns.
+ */
+QCOROCORE_EXPORT void setTracer(Tracer *tracer) noexcept;
+
+//! Returns the currently installed tracer, or \c nullptr if there's none.
+QCOROCORE_EXPORT Tracer *tracer() noexcept;
+
+} // namespace Tracing
+
+} // namespace QCoro
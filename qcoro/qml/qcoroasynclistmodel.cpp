@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoroasynclistmodel.h"
+#include "qcorosignal.h"
+#include "qcorotimer.h"
+
+#include <QPointer>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+using namespace std::chrono_literals;
+
+namespace QCoro {
+
+namespace detail {
+
+class AsyncListModelPrivate {
+public:
+    QVariantList rows;
+    int pageSize = 50;
+    int insertBatchSize = 20;
+    bool fetching = false;
+    bool atEnd = false;
+    bool failed = false;
+    //! Identifies the page being fetched.
+    /*!
+     * Incremented whenever a page fetch is started or canceled, so that rows of a canceled
+     * page are discarded even if a new fetch of the same rows has been started meanwhile.
+     */
+    quint64 generation = 0;
+};
+
+} // namespace detail
+
+AsyncListModel::AsyncListModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , d(std::make_unique<detail::AsyncListModelPrivate>())
+{}
+
+AsyncListModel::~AsyncListModel() {
+    // Cancel the pending page, but don't emit any signals from the destructor.
+    ++d->generation;
+    d->fetching = false;
+}
+
+int AsyncListModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(d->rows.size());
+}
+
+QVariant AsyncListModel::data(const QModelIndex &index, int role) const {
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return {};
+    }
+
+    const auto &row = d->rows.at(index.row());
+    if (role == Qt::DisplayRole) {
+        return row;
+    }
+    if (row.userType() == QMetaType::QVariantMap) {
+        const auto roleName = roleNames().value(role);
+        if (!roleName.isEmpty()) {
+            return row.toMap().value(QString::fromUtf8(roleName));
+        }
+    }
+    return {};
+}
+
+bool AsyncListModel::canFetchMore(const QModelIndex &parent) const {
+    return !parent.isValid() && !d->fetching && !d->atEnd && !d->failed;
+}
+
+void AsyncListModel::fetchMore(const QModelIndex &parent) {
+    if (canFetchMore(parent)) {
+        runFetch();
+    }
+}
+
+QVariant AsyncListModel::rowData(int row) const {
+    return d->rows.value(row);
+}
+
+int AsyncListModel::pageSize() const {
+    return d->pageSize;
+}
+
+void AsyncListModel::setPageSize(int pageSize) {
+    pageSize = std::max(pageSize, 1);
+    if (d->pageSize != pageSize) {
+        d->pageSize = pageSize;
+        Q_EMIT pageSizeChanged();
+    }
+}
+
+int AsyncListModel::insertBatchSize() const {
+    return d->insertBatchSize;
+}
+
+void AsyncListModel::setInsertBatchSize(int batchSize) {
+    batchSize = std::max(batchSize, 1);
+    if (d->insertBatchSize != batchSize) {
+        d->insertBatchSize = batchSize;
+        Q_EMIT insertBatchSizeChanged();
+    }
+}
+
+bool AsyncListModel::isLoading() const {
+    return d->fetching;
+}
+
+bool AsyncListModel::atEnd() const {
+    return d->atEnd;
+}
+
+QCoro::QmlTask AsyncListModel::fetchNext() {
+    return waitForFetch();
+}
+
+QCoro::QmlTask AsyncListModel::reload() {
+    cancelFetch();
+
+    beginResetModel();
+    d->rows.clear();
+    d->failed = false;
+    const bool wasAtEnd = std::exchange(d->atEnd, false);
+    endResetModel();
+
+    if (wasAtEnd) {
+        Q_EMIT atEndChanged();
+    }
+
+    return waitForFetch();
+}
+
+void AsyncListModel::cancelFetch() {
+    if (!d->fetching) {
+        return;
+    }
+
+    ++d->generation;
+    d->fetching = false;
+    Q_EMIT loadingChanged();
+    Q_EMIT fetchFinished(0);
+}
+
+AsyncListModel::FetchId AsyncListModel::currentFetch() const {
+    return d->generation;
+}
+
+bool AsyncListModel::isFetchCanceled(FetchId fetch) const {
+    return !d->fetching || d->generation != fetch;
+}
+
+QCoro::Task<int> AsyncListModel::waitForFetch() {
+    if (!d->fetching) {
+        if (!canFetchMore({})) {
+            co_return 0;
+        }
+        // Start awaiting the signal before starting the fetch, in case the page is ready immediately
+        auto finished = qCoro(this, &AsyncListModel::fetchFinished);
+        runFetch();
+        co_return co_await finished;
+    }
+
+    co_return co_await qCoro(this, &AsyncListModel::fetchFinished);
+}
+
+QCoro::Task<> AsyncListModel::runFetch() {
+    QPointer<AsyncListModel> self(this);
+    const auto generation = ++d->generation;
+    const int offset = static_cast<int>(d->rows.size());
+    const int count = d->pageSize;
+    d->fetching = true;
+    Q_EMIT loadingChanged();
+
+    QVariantList rows;
+    QString error;
+    try {
+        rows = co_await fetchPage(offset, count);
+    } catch (const std::exception &e) {
+        error = QString::fromUtf8(e.what());
+    } catch (...) {
+        error = QStringLiteral("Unknown error");
+    }
+
+    const auto isCanceled = [&]() { return !self || d->generation != generation; };
+    if (isCanceled()) {
+        co_return;
+    }
+
+    if (!error.isEmpty()) {
+        d->failed = true;
+        d->fetching = false;
+        Q_EMIT loadingChanged();
+        Q_EMIT errorOccurred(error);
+        Q_EMIT fetchFinished(0);
+        co_return;
+    }
+
+    // Insert the rows in batches, giving the event loop a chance to render a frame between them.
+    int inserted = 0;
+    while (inserted < rows.size()) {
+        if (inserted > 0) {
+            co_await QCoro::sleepFor(0ms);
+            if (isCanceled()) {
+                co_return;
+            }
+        }
+
+        const int batch = std::min(static_cast<int>(rows.size()) - inserted, d->insertBatchSize);
+        const int first = static_cast<int>(d->rows.size());
+        beginInsertRows({}, first, first + batch - 1);
+        std::move(rows.begin() + inserted, rows.begin() + inserted + batch, std::back_inserter(d->rows));
+        endInsertRows();
+        inserted += batch;
+    }
+
+    d->fetching = false;
+    const bool reachedEnd = rows.size() < count;
+    if (reachedEnd) {
+        d->atEnd = true;
+    }
+    Q_EMIT loadingChanged();
+    if (reachedEnd) {
+        Q_EMIT atEndChanged();
+    }
+    Q_EMIT fetchFinished(inserted);
+}
+
+} // namespace QCoro
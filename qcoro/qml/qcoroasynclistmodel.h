@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcoroqml_export.h"
+#include "qcoroqmltask.h"
+
+#include <QCoro/QCoroTask>
+#include <QAbstractListModel>
+#include <QVariantList>
+
+#include <memory>
+
+namespace QCoro {
+
+namespace detail {
+class AsyncListModelPrivate;
+} // namespace detail
+
+//! Base class for list models that fetch their rows asynchronously page by page.
+/*!
+ * Subclasses only need to re-implement fetchPage(). The model implements canFetchMore() and
+ * fetchMore(), so that views fetch new pages as they are scrolled. Only a single page is fetched
+ * at a time: when a view requests more data while a page is being fetched, the requests are
+ * coalesced. The fetched rows are inserted into the model in batches spread over multiple
+ * event loop iterations, so that inserting a large page doesn't block the UI.
+ */
+class QCOROQML_EXPORT AsyncListModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged)
+    Q_PROPERTY(bool atEnd READ atEnd NOTIFY atEndChanged)
+    Q_PROPERTY(int pageSize READ pageSize WRITE setPageSize NOTIFY pageSizeChanged)
+    Q_PROPERTY(int insertBatchSize READ insertBatchSize WRITE setInsertBatchSize NOTIFY insertBatchSizeChanged)
+
+public:
+    explicit AsyncListModel(QObject *parent = nullptr);
+    ~AsyncListModel() override;
+
+    int rowCount(const QModelIndex &parent = {}) const override;
+    //! Returns the row for Qt::DisplayRole, or the value for the role name if the row is a QVariantMap.
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    //! Returns the data of given row.
+    QVariant rowData(int row) const;
+
+    //! Returns the number of rows requested from fetchPage() at once. Defaults to 50.
+    int pageSize() const;
+    void setPageSize(int pageSize);
+
+    //! Returns the maximum number of rows inserted in a single event loop iteration. Defaults to 20.
+    int insertBatchSize() const;
+    void setInsertBatchSize(int batchSize);
+
+    //! Returns whether a page is being fetched.
+    bool isLoading() const;
+    //! Returns whether the last page has been fetched.
+    bool atEnd() const;
+
+    //! Fetches the next page, unless it is already being fetched.
+    /*!
+     * The returned task resolves to the number of rows inserted into the model once the
+     * page is fetched.
+     */
+    Q_INVOKABLE QCoro::QmlTask fetchNext();
+
+    //! Removes all rows from the model and fetches the first page again.
+    /*!
+     * The returned task resolves to the number of rows inserted into the model once the
+     * first page is fetched.
+     */
+    Q_INVOKABLE QCoro::QmlTask reload();
+
+    //! Cancels the page that is being fetched.
+    /*!
+     * Rows of the page that have already been inserted into the model are kept. This can be used
+     * to cancel fetching when the view is scrolled away from the end of the list.
+     */
+    Q_INVOKABLE void cancelFetch();
+
+Q_SIGNALS:
+    void loadingChanged();
+    void atEndChanged();
+    void pageSizeChanged();
+    void insertBatchSizeChanged();
+    //! Emitted when fetching a page finishes or is canceled, with the number of inserted rows.
+    void fetchFinished(int insertedRows);
+    //! Emitted when fetchPage() throws an exception.
+    /*!
+     * No more pages are fetched until reload() is called.
+     */
+    void errorOccurred(const QString &error);
+
+protected:
+    //! Fetches \c count rows starting at row \c offset.
+    /*!
+     * This function needs to be re-implemented in a subclass. Returning fewer than \c count rows
+     * indicates that there are no more rows.
+     */
+    virtual QCoro::Task<QVariantList> fetchPage(int offset, int count) = 0;
+
+    //! Identifies a single call to fetchPage().
+    using FetchId = quint64;
+
+    //! Returns the identifier of the page that is being fetched.
+    /*!
+     * Call this at the beginning of fetchPage(), before it is suspended for the first time,
+     * and pass the result to isFetchCanceled().
+     */
+    FetchId currentFetch() const;
+
+    //! Returns whether fetching of the page identified by \c fetch has been canceled.
+    /*!
+     * This can be used by fetchPage() to skip expensive work for pages that are no longer needed.
+     * A canceled page stays canceled even if the same rows are being fetched again, e.g. after
+     * reload().
+     */
+    bool isFetchCanceled(FetchId fetch) const;
+
+private:
+    QCoro::Task<> runFetch();
+    QCoro::Task<int> waitForFetch();
+
+    std::unique_ptr<detail::AsyncListModelPrivate> d;
+};
+
+} // namespace QCoro
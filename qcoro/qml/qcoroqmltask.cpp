@@ -5,8 +5,13 @@
 #include "qcoroqmltask.h"
 
 #include <QLoggingCategory>
+#include <QMetaObject>
+#include <QPointer>
+#include <QSet>
 
 #include <optional>
+#include <utility>
+#include <vector>
 
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_MSVC(4458 4201)
@@ -20,6 +25,7 @@ namespace QCoro {
 
 struct QmlTaskPrivate : public QSharedData {
     std::optional<QCoro::Task<QVariant>> task;
+    QPointer<QmlTaskListener> listener;
 
     QmlTaskPrivate() = default;
     QmlTaskPrivate(const QmlTaskPrivate &) : QSharedData() {
@@ -27,10 +33,99 @@ struct QmlTaskPrivate : public QSharedData {
     };
 };
 
+//! Returns the engine of the JavaScript value, or \c nullptr if the engine has been destroyed.
 inline QJSEngine *getEngineForValue(const QJSValue &val) {
-    return QJSValuePrivate::engine(&val)->jsEngine();
+    auto *engine = QJSValuePrivate::engine(&val);
+    return engine ? engine->jsEngine() : nullptr;
 }
 
+namespace {
+
+void callFunction(QJSValue &func, const QVariant &result) {
+    // The engine may have been destroyed while the task was running
+    auto *engine = getEngineForValue(func);
+    if (!engine) {
+        return;
+    }
+    auto jsval = engine->toScriptValue(result);
+    func.call({jsval});
+}
+
+//! Delivers results of finished QmlTasks to QML in batches.
+/*!
+ * When many tasks finish during a single event loop iteration (e.g. when a list view
+ * loads data for all its delegates), their results are collected and delivered together
+ * in a single pass in the next event loop iteration, instead of each task updating its
+ * listener and calling into JavaScript separately as soon as it finishes.
+ */
+class QmlTaskDispatcher : public QObject {
+public:
+    static QmlTaskDispatcher *instance() {
+        static thread_local QmlTaskDispatcher dispatcher;
+        return &dispatcher;
+    }
+
+    void deliverValue(QPointer<QmlTaskListener> listener, QVariant &&value) {
+        mPendingValues.emplace_back(std::move(listener), std::move(value));
+        scheduleFlush();
+    }
+
+    void deliverCallback(QJSValue &&func, QVariant &&value) {
+        auto *engine = getEngineForValue(func);
+        if (!engine) {
+            return;
+        }
+        // Don't keep the callbacks around once their engine is gone
+        if (!mWatchedEngines.contains(engine)) {
+            mWatchedEngines.insert(engine);
+            connect(engine, &QObject::destroyed, this, [this, engine]() { dropCallbacks(engine); });
+        }
+        mPendingCallbacks.push_back({engine, std::move(func), std::move(value)});
+        scheduleFlush();
+    }
+
+private:
+    struct PendingCallback {
+        QObject *engine;
+        QJSValue func;
+        QVariant value;
+    };
+
+    void dropCallbacks(QObject *engine) {
+        mWatchedEngines.remove(engine);
+        std::erase_if(mPendingCallbacks, [engine](const auto &callback) { return callback.engine == engine; });
+    }
+
+    void scheduleFlush() {
+        if (!std::exchange(mFlushScheduled, true)) {
+            QMetaObject::invokeMethod(this, &QmlTaskDispatcher::flush, Qt::QueuedConnection);
+        }
+    }
+
+    void flush() {
+        mFlushScheduled = false;
+        // Tasks finishing while we are delivering the results will go into the next batch
+        auto values = std::exchange(mPendingValues, {});
+        auto callbacks = std::exchange(mPendingCallbacks, {});
+
+        for (auto &[listener, value] : values) {
+            if (listener) {
+                listener->setValue(std::move(value));
+            }
+        }
+        for (auto &callback : callbacks) {
+            callFunction(callback.func, callback.value);
+        }
+    }
+
+    std::vector<std::pair<QPointer<QmlTaskListener>, QVariant>> mPendingValues;
+    std::vector<PendingCallback> mPendingCallbacks;
+    QSet<QObject *> mWatchedEngines;
+    bool mFlushScheduled = false;
+};
+
+} // namespace
+
 QmlTask::QmlTask() noexcept : d(new QmlTaskPrivate())
 {
 }
@@ -57,20 +152,40 @@ void QmlTask::then(QJSValue func) {
         return;
     }
 
-    d->task->then([func = std::move(func)](const QVariant &result) mutable -> void {
-        auto jsval = getEngineForValue(func)->toScriptValue(result);
-        func.call({jsval});
+    // If the task has already finished, the continuation is invoked synchronously and
+    // there's no need to wait for the next batch.
+    const bool ready = d->task->isReady();
+    d->task->then([func = std::move(func), ready](QVariant result) mutable -> void {
+        if (ready) {
+            callFunction(func, result);
+        } else {
+            QmlTaskDispatcher::instance()->deliverCallback(std::move(func), std::move(result));
+        }
     });
 }
 
 QmlTaskListener *QmlTask::await(const QVariant &intermediateValue)
 {
-    QPointer listener = new QmlTaskListener();
+    // Awaiting the same task repeatedly reuses the listener
+    if (d->listener) {
+        // Update the intermediate value, unless the listener already has (or is about to get) the result
+        if (!intermediateValue.isNull() && !d->task->isReady()) {
+            d->listener->setValue(QVariant(intermediateValue));
+        }
+        return d->listener;
+    }
+
+    auto *listener = new QmlTaskListener();
+    d->listener = listener;
     if (!intermediateValue.isNull()) {
         listener->setValue(QVariant(intermediateValue));
     }
-    d->task->then([listener](auto &&value) {
-        if (listener) {
+
+    const bool ready = d->task->isReady();
+    d->task->then([listener = QPointer(listener), ready](QVariant value) mutable {
+        if (!ready) {
+            QmlTaskDispatcher::instance()->deliverValue(std::move(listener), std::move(value));
+        } else if (listener) {
             listener->setValue(std::move(value));
         }
     });
@@ -91,6 +91,9 @@ public:
      *
      * Optionally, an intermediate value can be passed to await,
      * which will be returned by value while calculating the asynchronous result.
+     *
+     * Calling await() repeatedly on the same task returns the same listener. If the result
+     * is not available yet, its value is replaced by the new intermediate value.
      */
     Q_INVOKABLE QCoro::QmlTaskListener *await(const QVariant &intermediateValue = {});
 
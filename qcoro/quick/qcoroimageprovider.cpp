@@ -3,6 +3,22 @@
 // SPDX-License-Identifier: MIT
 
 #include "qcoroimageprovider.h"
+#include "qcorofuture.h"
+
+#include <QBuffer>
+#include <QCache>
+#include <QHash>
+#include <QImageReader>
+#include <QList>
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QPromise>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
 
 namespace QCoro {
 
@@ -11,33 +27,277 @@ class QCoroImageResponse : public QQuickImageResponse {
 
 public:
     QQuickTextureFactory *textureFactory() const override;
-    void reportFinished(QImage &&image);
+    QString errorString() const override;
+    void cancel() override;
+
+    bool isCanceled() const;
+    void reportFinished(std::unique_ptr<QQuickTextureFactory> &&textureFactory);
+    void reportError(const QString &error);
 
 private:
-    QImage m_image;
+    // Ownership of the factory is transferred to the engine in textureFactory()
+    mutable std::unique_ptr<QQuickTextureFactory> m_textureFactory;
+    QString m_error;
+    std::atomic<bool> m_canceled = false;
 };
 
+namespace detail {
 
-ImageProvider::ImageProvider() = default;
+struct ImageRequestKey {
+    QString id;
+    QSize requestedSize;
 
-QQuickImageResponse *ImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize) {
-    auto task = asyncRequestImage(id, requestedSize);
+    bool operator==(const ImageRequestKey &other) const = default;
+};
 
-    auto *response = new QCoroImageResponse();
+size_t qHash(const ImageRequestKey &key, size_t seed = 0) noexcept {
+    return qHashMulti(seed, key.id, key.requestedSize.width(), key.requestedSize.height());
+}
+
+//! Texture factory that shares the texture with other responses and with the cache.
+class SharedTextureFactory : public QQuickTextureFactory {
+public:
+    explicit SharedTextureFactory(std::shared_ptr<QQuickTextureFactory> textureFactory)
+        : m_textureFactory(std::move(textureFactory)) {}
+
+    QSGTexture *createTexture(QQuickWindow *window) const override {
+        return m_textureFactory->createTexture(window);
+    }
+    QSize textureSize() const override {
+        return m_textureFactory->textureSize();
+    }
+    int textureByteCount() const override {
+        return m_textureFactory->textureByteCount();
+    }
+    QImage image() const override {
+        return m_textureFactory->image();
+    }
+
+private:
+    std::shared_ptr<QQuickTextureFactory> m_textureFactory;
+};
+
+std::unique_ptr<QQuickTextureFactory> shareTextureFactory(const std::shared_ptr<QQuickTextureFactory> &textureFactory) {
+    if (!textureFactory) {
+        return {};
+    }
+    return std::make_unique<SharedTextureFactory>(textureFactory);
+}
+
+//! All the responses waiting for the same image.
+struct ImageRequest {
+    QList<QPointer<QCoroImageResponse>> responses;
+
+    bool isCanceled() const {
+        return std::all_of(responses.cbegin(), responses.cend(), [](const auto &response) {
+            return !response || response->isCanceled();
+        });
+    }
+};
+
+class ImageProviderPrivate {
+public:
+    explicit ImageProviderPrivate(ImageProvider *q)
+        : q(q) {
+        cache.setMaxCost(0);
+    }
+
+    QCoro::Task<> load(ImageRequestKey key);
+
+    ImageProvider *q;
+    mutable QMutex mutex;
+    QCache<ImageRequestKey, std::shared_ptr<QQuickTextureFactory>> cache;
+    QHash<ImageRequestKey, std::shared_ptr<ImageRequest>> pendingRequests;
+    QThreadPool *decodePool = QThreadPool::globalInstance();
+};
+
+QCoro::Task<> ImageProviderPrivate::load(ImageRequestKey key) {
+    std::shared_ptr<QQuickTextureFactory> textureFactory;
+    QString error;
+    try {
+        textureFactory = co_await q->asyncRequestTexture(key.id, key.requestedSize);
+    } catch (const std::exception &e) {
+        error = QString::fromUtf8(e.what());
+    } catch (...) {
+        error = QStringLiteral("Unknown error");
+    }
+
+    QMutexLocker locker(&mutex);
+    const auto request = pendingRequests.take(key);
+    if (textureFactory && textureFactory->textureByteCount() <= cache.maxCost()) {
+        cache.insert(key, new std::shared_ptr<QQuickTextureFactory>(textureFactory), textureFactory->textureByteCount());
+    }
+    locker.unlock();
+
+    for (const auto &response : std::as_const(request->responses)) {
+        if (!response || response->isCanceled()) {
+            continue;
+        }
+        if (error.isEmpty()) {
+            response->reportFinished(shareTextureFactory(textureFactory));
+        } else {
+            response->reportError(error);
+        }
+    }
+}
+
+} // namespace detail
+
+namespace {
+
+QSize scaledImageSize(const QSize &imageSize, const QSize &requestedSize) {
+    if (imageSize.isEmpty()) {
+        return {};
+    }
+
+    // Only a single dimension may be requested, the other one is then derived from the aspect ratio
+    QSize size = requestedSize;
+    if (size.width() <= 0 && size.height() <= 0) {
+        return {};
+    } else if (size.width() <= 0) {
+        size.setWidth(imageSize.width() * size.height() / imageSize.height());
+    } else if (size.height() <= 0) {
+        size.setHeight(imageSize.height() * size.width() / imageSize.width());
+    }
+
+    // Never upscale the image
+    if (size.width() >= imageSize.width() && size.height() >= imageSize.height()) {
+        return {};
+    }
+    return imageSize.scaled(size, Qt::KeepAspectRatio);
+}
+
+} // namespace
+
+ImageProvider::ImageProvider()
+    : d(std::make_unique<detail::ImageProviderPrivate>(this))
+{}
 
-    task.then([response](QImage &&image) {
-        response->reportFinished(std::move(image));
+ImageProvider::~ImageProvider() = default;
+
+QCoro::Task<QImage> ImageProvider::asyncRequestImage(const QString &id, const QSize &requestedSize) {
+    Q_UNUSED(requestedSize);
+    qWarning("QCoro::ImageProvider: neither asyncRequestImage() nor asyncRequestTexture() is re-implemented, "
+             "cannot provide image %s", qUtf8Printable(id));
+    co_return QImage{};
+}
+
+QCoro::Task<std::unique_ptr<QQuickTextureFactory>> ImageProvider::asyncRequestTexture(const QString &id, const QSize &requestedSize) {
+    const QImage image = co_await asyncRequestImage(id, requestedSize);
+    co_return std::unique_ptr<QQuickTextureFactory>(QQuickTextureFactory::textureFactoryForImage(image));
+}
+
+void ImageProvider::setCacheCapacity(qsizetype bytes) {
+    QMutexLocker locker(&d->mutex);
+    d->cache.setMaxCost(bytes);
+}
+
+qsizetype ImageProvider::cacheCapacity() const {
+    QMutexLocker locker(&d->mutex);
+    return d->cache.maxCost();
+}
+
+void ImageProvider::clearCache() {
+    QMutexLocker locker(&d->mutex);
+    d->cache.clear();
+}
+
+void ImageProvider::setDecodeThreadPool(QThreadPool *pool) {
+    QMutexLocker locker(&d->mutex);
+    d->decodePool = pool;
+}
+
+QThreadPool *ImageProvider::decodeThreadPool() const {
+    QMutexLocker locker(&d->mutex);
+    return d->decodePool;
+}
+
+QCoro::Task<QImage> ImageProvider::decodeImage(QByteArray data, QSize requestedSize) {
+    auto promise = std::make_shared<QPromise<QImage>>();
+    auto future = promise->future();
+    decodeThreadPool()->start([promise, data = std::move(data), requestedSize]() mutable {
+        promise->start();
+        QBuffer buffer(&data);
+        QImageReader reader(&buffer);
+        if (const auto size = scaledImageSize(reader.size(), requestedSize); size.isValid()) {
+            reader.setScaledSize(size);
+        }
+        QImage image = reader.read();
+        // Convert the image into a format that can be uploaded to the GPU directly while
+        // we are still in the worker thread.
+        if (!image.isNull() && image.format() != QImage::Format_RGB32
+            && image.format() != QImage::Format_ARGB32_Premultiplied) {
+            image.convertTo(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32);
+        }
+        promise->addResult(std::move(image));
+        promise->finish();
     });
 
+    co_return co_await future;
+}
+
+bool ImageProvider::isRequestCanceled(const QString &id, const QSize &requestedSize) const {
+    QMutexLocker locker(&d->mutex);
+    const auto request = d->pendingRequests.value(detail::ImageRequestKey{id, requestedSize});
+    return !request || request->isCanceled();
+}
+
+QQuickImageResponse *ImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize) {
+    auto *response = new QCoroImageResponse();
+    detail::ImageRequestKey key{id, requestedSize};
+
+    QMutexLocker locker(&d->mutex);
+    if (const auto *textureFactory = d->cache.object(key)) {
+        auto sharedTextureFactory = detail::shareTextureFactory(*textureFactory);
+        locker.unlock();
+        response->reportFinished(std::move(sharedTextureFactory));
+        return response;
+    }
+
+    auto &request = d->pendingRequests[key];
+    if (request) {
+        // The same image is already being loaded, just wait for the result
+        request->responses.push_back(response);
+        return response;
+    }
+
+    request = std::make_shared<detail::ImageRequest>();
+    request->responses.push_back(response);
+    locker.unlock();
+
+    d->load(std::move(key));
     return response;
 }
 
 QQuickTextureFactory *QCoroImageResponse::textureFactory() const {
-    return QQuickTextureFactory::textureFactoryForImage(m_image);
+    return m_textureFactory.release();
+}
+
+QString QCoroImageResponse::errorString() const {
+    return m_error;
+}
+
+void QCoroImageResponse::cancel() {
+    if (m_canceled.exchange(true)) {
+        return;
+    }
+
+    // The engine expects the finished() signal even for canceled responses. Nothing references
+    // a canceled response anymore, so we can emit it right away, but not from within cancel().
+    QMetaObject::invokeMethod(this, [this]() { Q_EMIT finished(); }, Qt::QueuedConnection);
+}
+
+bool QCoroImageResponse::isCanceled() const {
+    return m_canceled;
+}
+
+void QCoroImageResponse::reportFinished(std::unique_ptr<QQuickTextureFactory> &&textureFactory) {
+    m_textureFactory = std::move(textureFactory);
+    Q_EMIT finished();
 }
 
-void QCoroImageResponse::reportFinished(QImage &&image) {
-    m_image = image;
+void QCoroImageResponse::reportError(const QString &error) {
+    m_error = error;
     Q_EMIT finished();
 }
 
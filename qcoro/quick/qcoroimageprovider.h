@@ -10,18 +10,78 @@
 
 #include "qcoroquick_export.h"
 
+#include <memory>
+
+class QThreadPool;
+
 namespace QCoro {
 
+namespace detail {
+class ImageProviderPrivate;
+} // namespace detail
+
 //! Base class for coroutines based image providers
+/*!
+ * Concurrent requests for the same image (same id and requested size) are coalesced, so that
+ * asyncRequestImage() is only invoked once and its result is delivered to all the requests.
+ * Optionally, the images can be cached in a LRU cache, see setCacheCapacity().
+ */
 class QCOROQUICK_EXPORT ImageProvider : public QQuickAsyncImageProvider {
 public:
     explicit ImageProvider();
+    ~ImageProvider() override;
+
+    //! This function needs to be re-implemented in a subclass, unless asyncRequestTexture() is re-implemented.
+    virtual QCoro::Task<QImage> asyncRequestImage(const QString &id, const QSize &requestedSize);
+
+    //! Can be re-implemented in a subclass to provide a texture factory instead of an image.
+    /*!
+     * This allows providers to hand over pre-built textures, e.g. compressed texture data, directly
+     * to the scene graph. The default implementation wraps the image returned from asyncRequestImage()
+     * into a texture factory.
+     */
+    virtual QCoro::Task<std::unique_ptr<QQuickTextureFactory>> asyncRequestTexture(const QString &id, const QSize &requestedSize);
 
-    //! This function needs to be re-implemented in a subclass.
-    virtual QCoro::Task<QImage> asyncRequestImage(const QString &id, const QSize &requestedSize) = 0;
+    //! Sets the maximum total size of cached images in bytes.
+    /*!
+     * The least recently used images are evicted from the cache when the total size would exceed
+     * the capacity. The default capacity is 0, which disables the cache.
+     */
+    void setCacheCapacity(qsizetype bytes);
+    //! Returns the maximum total size of cached images in bytes.
+    qsizetype cacheCapacity() const;
+    //! Removes all images from the cache.
+    void clearCache();
+
+    //! Sets the thread pool in which decodeImage() decodes the images.
+    /*!
+     * By default the global thread pool is used.
+     */
+    void setDecodeThreadPool(QThreadPool *pool);
+    //! Returns the thread pool in which decodeImage() decodes the images.
+    QThreadPool *decodeThreadPool() const;
+
+protected:
+    //! Decodes the encoded image \c data in the decode thread pool.
+    /*!
+     * If \c requestedSize is valid, the image is scaled down while decoding to fit the
+     * requested size, keeping the aspect ratio. The image is also converted to a format
+     * that can be uploaded into a texture without further conversion. Returns a null image
+     * if the data cannot be decoded.
+     */
+    QCoro::Task<QImage> decodeImage(QByteArray data, QSize requestedSize);
+
+    //! Returns whether all the requests for given image have been canceled.
+    /*!
+     * This can be used by asyncRequestImage() to skip expensive work for images that
+     * are no longer needed.
+     */
+    bool isRequestCanceled(const QString &id, const QSize &requestedSize) const;
 
 private:
     QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
+
+    std::unique_ptr<detail::ImageProviderPrivate> d;
 };
 
 }
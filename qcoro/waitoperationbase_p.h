@@ -6,6 +6,8 @@
 
 #include "macros_p.h"
 #include "coroutine.h"
+#include "qcorodeadline.h"
+#include "qcorotracing.h"
 
 #include <QTimer>
 #include <memory>
@@ -27,6 +29,8 @@ public:
 
 protected:
     WaitOperationBase(T *obj, int timeout_msecs) : mObj{obj} {
+        // Time out at the deadline of the awaiting coroutine at the latest
+        timeout_msecs = timeoutWithDeadline(timeout_msecs);
         if (timeout_msecs > -1) {
             mTimeoutTimer = std::make_unique<QTimer>();
             mTimeoutTimer->setInterval(timeout_msecs);
@@ -54,13 +58,20 @@ protected:
 
         QObject::disconnect(mConn);
 
-        QTimer::singleShot(0, [awaitingCoroutine]() mutable { awaitingCoroutine.resume(); });
+        tracing::SuspensionTrace queued;
+        queued.suspended(Tracing::SuspensionKind::Queued, awaitingCoroutine);
+        QTimer::singleShot(0, [awaitingCoroutine, queued]() mutable {
+            queued.resumed();
+            awaitingCoroutine.resume();
+        });
     }
 
     QPointer<T> mObj;
     std::unique_ptr<QTimer> mTimeoutTimer;
     QMetaObject::Connection mConn;
     bool mTimedOut = false;
+    //! Reports the suspension to QCoro::Tracing, derived classes call it from await_suspend() and await_resume()
+    QCORO_NO_UNIQUE_ADDRESS tracing::SuspensionTrace mTrace;
 };
 
 } // namespace QCoro::detail
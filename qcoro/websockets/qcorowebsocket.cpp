@@ -23,7 +23,7 @@ Q_DECLARE_METATYPE(std::optional<std::tuple<QString>>)
 
 namespace {
 
-class WebSocketStateWatcher : public QObject {
+class WebSocketStateWatcher : public QObject, public QCoro::detail::tracing::IOSignalSource {
     Q_OBJECT
 public:
     WebSocketStateWatcher(QWebSocket *socket, QAbstractSocket::SocketState desiredState)
@@ -80,7 +80,7 @@ public:
 template<typename ... Args>
 using unwrapped_signal_args_t = typename unwrapped_signal_args<Args ...>::type;
 
-class WebSocketSignalWatcher : public QObject {
+class WebSocketSignalWatcher : public QObject, public QCoro::detail::tracing::IOSignalSource {
     Q_OBJECT
 public:
     template<typename Signal>
@@ -12,7 +12,7 @@ using namespace QCoro::detail;
 
 namespace {
 
-class QCoroWebSocketServerSignalListener : public QObject {
+class QCoroWebSocketServerSignalListener : public QObject, public QCoro::detail::tracing::IOSignalSource {
     Q_OBJECT
 public:
     QCoroWebSocketServerSignalListener(QWebSocketServer *server) {
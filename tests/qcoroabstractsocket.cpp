@@ -338,6 +338,45 @@ private:
         QVERIFY(mServer.waitForConnection());
     }
 
+    QCoro::Task<> testTryConnectToHost_coro(QCoro::TestContext) {
+        QTcpSocket socket;
+        const auto result = co_await qCoro(socket).tryConnectToHost(QHostAddress::LocalHost, mServer.port());
+        QCORO_VERIFY(result.has_value());
+        QCORO_COMPARE(socket.state(), QAbstractSocket::ConnectedState);
+
+        socket.write("GET /stream HTTP/1.1\r\n");
+        const auto data = co_await qCoro(socket).tryReadAll();
+        QCORO_VERIFY(data.has_value());
+        QCORO_VERIFY(!data->isEmpty());
+
+        QCORO_VERIFY(mServer.waitForConnection());
+    }
+
+    QCoro::Task<> testTryConnectToHostRefused_coro(QCoro::TestContext) {
+        mServer.setExpectTimeout(true); // no-one connects to the test server
+
+        // Find a port that no-one is listening on
+        QTcpServer closedServer;
+        QCORO_VERIFY(closedServer.listen(QHostAddress::LocalHost));
+        const auto closedPort = closedServer.serverPort();
+        closedServer.close();
+
+        QTcpSocket socket;
+        const auto result = co_await qCoro(socket).tryConnectToHost(QHostAddress::LocalHost, closedPort);
+        QCORO_VERIFY(!result.has_value());
+        QCORO_COMPARE(result.error(), QAbstractSocket::ConnectionRefusedError);
+    }
+
+    QCoro::Task<> testTryWaitForConnectedUnconnected_coro(QCoro::TestContext) {
+        mServer.setExpectTimeout(true);
+
+        // The socket is not connecting at all, so it fails immediately instead of timing out
+        QTcpSocket socket;
+        const auto result = co_await qCoro(socket).tryWaitForConnected(10s);
+        QCORO_VERIFY(!result.has_value());
+        QCORO_COMPARE(result.error(), socket.error());
+    }
+
 private Q_SLOTS:
     void init() {
         mServer.start(QHostAddress::LocalHost);
@@ -357,6 +396,9 @@ private Q_SLOTS:
     addCoroAndThenTests(ReadAllTriggers)
     addCoroAndThenTests(ReadTriggers)
     addCoroAndThenTests(ReadLineTriggers)
+    addTest(TryConnectToHost)
+    addTest(TryConnectToHostRefused)
+    addTest(TryWaitForConnectedUnconnected)
 
 private:
     TestHttpServer<QTcpServer> mServer;
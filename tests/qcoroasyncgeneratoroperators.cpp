@@ -0,0 +1,395 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoroasyncgeneratoroperators.h"
+#include "qcorotimer.h"
+#include "testobject.h"
+
+#include <QElapsedTimer>
+#include <QScopeGuard>
+#include <QThread>
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+struct Moveonly {
+    explicit constexpr Moveonly(int val): val(val) {}
+    Moveonly(const Moveonly &) = delete;
+    Moveonly &operator=(const Moveonly &) = delete;
+    Moveonly(Moveonly &&) noexcept = default;
+    Moveonly &operator=(Moveonly &&) noexcept = default;
+    ~Moveonly() = default;
+
+    int val;
+};
+
+namespace {
+
+QCoro::AsyncGenerator<int> syncGenerator(int count, int offset = 0) {
+    for (int i = 0; i < count; ++i) {
+        co_yield offset + i;
+    }
+}
+
+QCoro::AsyncGenerator<int> timedGenerator(int count, std::chrono::milliseconds interval, int offset = 0) {
+    for (int i = 0; i < count; ++i) {
+        co_await QCoro::sleepFor(interval);
+        co_yield offset + i;
+    }
+}
+
+} // namespace
+
+class AsyncGeneratorOperatorsTest : public QCoro::TestObject<AsyncGeneratorOperatorsTest> {
+    Q_OBJECT
+private:
+    QCoro::Task<> testMapFilterTake_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        std::vector<int> values;
+        QCORO_FOREACH(int value, syncGenerator(100)
+                                     | QCoro::map([](int value) { return value * 2; })
+                                     | QCoro::filter([](int value) { return value % 3 == 0; })
+                                     | QCoro::take(4)) {
+            values.push_back(value);
+        }
+
+        QCORO_COMPARE(values, (std::vector<int>{0, 6, 12, 18}));
+    }
+
+    QCoro::Task<> testTakeStopsPulling_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        int produced = 0;
+        const auto createGenerator = [&produced]() -> QCoro::AsyncGenerator<int> {
+            while (true) {
+                co_yield produced++;
+            }
+        };
+
+        std::vector<int> values;
+        QCORO_FOREACH(int value, createGenerator() | QCoro::take(3)) {
+            values.push_back(value);
+        }
+
+        QCORO_COMPARE(values, (std::vector<int>{0, 1, 2}));
+        QCORO_COMPARE(produced, 3);
+    }
+
+    QCoro::Task<> testTakeZero_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        int produced = 0;
+        const auto createGenerator = [&produced]() -> QCoro::AsyncGenerator<int> {
+            while (true) {
+                co_yield produced++;
+            }
+        };
+
+        std::vector<int> values;
+        QCORO_FOREACH(int value, createGenerator() | QCoro::map([](int value) { return value * 2; }) | QCoro::take(0)) {
+            values.push_back(value);
+        }
+
+        QCORO_VERIFY(values.empty());
+        QCORO_COMPARE(produced, 0);
+    }
+
+    QCoro::Task<> testPipelineToGenerator_coro(QCoro::TestContext) {
+        QCoro::AsyncGenerator<QString> generator = timedGenerator(3, 10ms)
+            | QCoro::map([](int value) { return QString::number(value); });
+
+        QStringList values;
+        QCORO_FOREACH(const QString &value, generator) {
+            values.push_back(value);
+        }
+
+        QCORO_COMPARE(values, (QStringList{QStringLiteral("0"), QStringLiteral("1"), QStringLiteral("2")}));
+    }
+
+    QCoro::Task<> testMoveonly_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        const auto createGenerator = []() -> QCoro::AsyncGenerator<Moveonly> {
+            for (int i = 0; i < 4; ++i) {
+                co_yield Moveonly{i};
+            }
+        };
+
+        std::vector<int> values;
+        QCORO_FOREACH(const Moveonly &value, createGenerator()
+                                                 | QCoro::filter([](const Moveonly &value) { return value.val != 1; })) {
+            values.push_back(value.val);
+        }
+
+        QCORO_COMPARE(values, (std::vector<int>{0, 2, 3}));
+    }
+
+    QCoro::Task<> testChunk_coro(QCoro::TestContext) {
+        std::vector<std::vector<int>> chunks;
+        QCORO_FOREACH(const std::vector<int> &chunk, timedGenerator(7, 5ms) | QCoro::chunk(3)) {
+            chunks.push_back(chunk);
+        }
+
+        QCORO_COMPARE(chunks, (std::vector<std::vector<int>>{{0, 1, 2}, {3, 4, 5}, {6}}));
+    }
+
+    QCoro::Task<> testFusedChunk_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        std::vector<std::vector<int>> chunks;
+        QCORO_FOREACH(const std::vector<int> &chunk, syncGenerator(10)
+                                                         | QCoro::filter([](int value) { return value % 2 == 1; })
+                                                         | QCoro::chunk(2)) {
+            chunks.push_back(chunk);
+        }
+
+        QCORO_COMPARE(chunks, (std::vector<std::vector<int>>{{1, 3}, {5, 7}, {9}}));
+    }
+
+    QCoro::Task<> testWindow_coro(QCoro::TestContext) {
+        const auto createGenerator = []() -> QCoro::AsyncGenerator<int> {
+            co_yield 1;
+            co_yield 2;
+            co_await QCoro::sleepFor(300ms);
+            co_yield 3;
+        };
+
+        std::vector<std::vector<int>> windows;
+        QCORO_FOREACH(const std::vector<int> &window, createGenerator() | QCoro::window(100ms)) {
+            windows.push_back(window);
+        }
+
+        QCORO_COMPARE(windows, (std::vector<std::vector<int>>{{1, 2}, {3}}));
+    }
+
+    QCoro::Task<> testWindowMaxSize_coro(QCoro::TestContext) {
+        std::vector<std::vector<int>> windows;
+        QCORO_FOREACH(const std::vector<int> &window, timedGenerator(5, 5ms) | QCoro::window(10s, 2)) {
+            windows.push_back(window);
+        }
+
+        QCORO_COMPARE(windows, (std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4}}));
+    }
+
+    QCoro::Task<> testMerge_coro(QCoro::TestContext) {
+        std::vector<int> values;
+        QCORO_FOREACH(int value, QCoro::merge(timedGenerator(3, 40ms), timedGenerator(3, 100ms, 100))) {
+            values.push_back(value);
+        }
+
+        QCORO_COMPARE(values, (std::vector<int>{0, 1, 100, 2, 101, 102}));
+    }
+
+    QCoro::Task<> testMergeException_coro(QCoro::TestContext) {
+        const auto createGenerator = []() -> QCoro::AsyncGenerator<int> {
+            co_await QCoro::sleepFor(20ms);
+            throw std::runtime_error("Merge this!");
+            co_yield 0;
+        };
+
+        auto generator = QCoro::merge(timedGenerator(10, 50ms), createGenerator());
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await generator.begin(), std::runtime_error);
+    }
+
+    QCoro::Task<> testDestroyMerge_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        bool destroyed = false;
+        const auto createGenerator = [&destroyed]() -> QCoro::AsyncGenerator<int> {
+            const auto guard = qScopeGuard([&destroyed]() { destroyed = true; });
+            while (true) {
+                co_yield 42;
+            }
+        };
+
+        {
+            auto generator = QCoro::merge(createGenerator(), syncGenerator(1, 100));
+            const auto it = co_await generator.begin();
+            QCORO_COMPARE(*it, 42);
+        }
+
+        QCORO_VERIFY(destroyed);
+    }
+
+    QCoro::Task<> testZip_coro(QCoro::TestContext) {
+        const auto createGenerator = []() -> QCoro::AsyncGenerator<QString> {
+            co_yield QStringLiteral("zero");
+            co_await QCoro::sleepFor(10ms);
+            co_yield QStringLiteral("one");
+        };
+
+        std::vector<std::pair<int, QString>> values;
+        QCORO_FOREACH(const auto &value, QCoro::zip(timedGenerator(5, 5ms), createGenerator())) {
+            values.push_back(value);
+        }
+
+        QCORO_COMPARE(values, (std::vector<std::pair<int, QString>>{{0, QStringLiteral("zero")},
+                                                                    {1, QStringLiteral("one")}}));
+    }
+
+    QCoro::Task<> testStageException_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        auto pipeline = syncGenerator(5) | QCoro::map([](int value) {
+            if (value == 2) {
+                throw std::runtime_error("Not two again!");
+            }
+            return value;
+        });
+
+        auto it = co_await pipeline.begin();
+        QCORO_COMPARE(*it, 0);
+        co_await ++it;
+        QCORO_COMPARE(*it, 1);
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await ++it, std::runtime_error);
+        QCORO_COMPARE(it, pipeline.end());
+    }
+
+    QCoro::Task<> testPrefetch_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        int produced = 0;
+        const auto createGenerator = [&produced]() -> QCoro::AsyncGenerator<int> {
+            for (int i = 0; i < 10; ++i) {
+                ++produced;
+                co_yield i;
+            }
+        };
+
+        auto generator = createGenerator() | QCoro::prefetch(3);
+        auto it = co_await generator.begin();
+        QCORO_COMPARE(*it, 0);
+        // The current value plus three prefetched values
+        QCORO_COMPARE(produced, 4);
+
+        std::vector<int> values;
+        while (it != generator.end()) {
+            values.push_back(*it);
+            co_await ++it;
+        }
+        QCORO_COMPARE(values, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+
+    QCoro::Task<> testPrefetchOverlap_coro(QCoro::TestContext) {
+        QElapsedTimer timer;
+        timer.start();
+
+        std::vector<int> values;
+        QCORO_FOREACH(int value, timedGenerator(4, 100ms) | QCoro::prefetch(2)) {
+            values.push_back(value);
+            co_await QCoro::sleepFor(100ms);
+        }
+
+        QCORO_COMPARE(values, (std::vector<int>{0, 1, 2, 3}));
+        // Without prefetching this would take 800ms
+        QCORO_VERIFY(timer.elapsed() < 700);
+    }
+
+    QCoro::Task<> testPrefetchException_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        const auto createGenerator = []() -> QCoro::AsyncGenerator<int> {
+            co_yield 1;
+            co_yield 2;
+            throw std::runtime_error("Prefetch this!");
+        };
+
+        auto generator = createGenerator() | QCoro::prefetch(5);
+        auto it = co_await generator.begin();
+        QCORO_COMPARE(*it, 1);
+        co_await ++it;
+        QCORO_COMPARE(*it, 2);
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await ++it, std::runtime_error);
+    }
+
+    QCoro::Task<> testParallelMapInputOrder_coro(QCoro::TestContext) {
+        const auto *consumerThread = QThread::currentThread();
+        std::vector<int> values;
+        QCORO_FOREACH(int value, syncGenerator(8) | QCoro::parallelMap([](int value) {
+                                     // Later values finish first
+                                     QThread::sleep(std::chrono::milliseconds{(8 - value) * 5});
+                                     return value * 10;
+                                 }, 4)) {
+            QCORO_COMPARE(QThread::currentThread(), consumerThread);
+            values.push_back(value);
+        }
+
+        QCORO_COMPARE(values, (std::vector<int>{0, 10, 20, 30, 40, 50, 60, 70}));
+    }
+
+    QCoro::Task<> testParallelMapCompletionOrder_coro(QCoro::TestContext) {
+        std::vector<int> values;
+        QCORO_FOREACH(int value, QCoro::parallelMap(syncGenerator(3), [](int value) {
+                                     QThread::sleep(std::chrono::milliseconds{(3 - value) * 100});
+                                     return value;
+                                 }, 3, QCoro::ResultOrder::CompletionOrder)) {
+            values.push_back(value);
+        }
+
+        QCORO_COMPARE(values, (std::vector<int>{2, 1, 0}));
+    }
+
+    QCoro::Task<> testParallelMapConcurrency_coro(QCoro::TestContext) {
+        std::atomic<int> running = 0;
+        std::atomic<int> maxRunning = 0;
+        int count = 0;
+        QCORO_FOREACH(int value, timedGenerator(12, 1ms) | QCoro::parallelMap([&](int value) {
+                                     const int current = ++running;
+                                     int expected = maxRunning;
+                                     while (current > expected && !maxRunning.compare_exchange_weak(expected, current)) {}
+                                     QThread::sleep(std::chrono::milliseconds{10});
+                                     --running;
+                                     return value;
+                                 }, 3)) {
+            Q_UNUSED(value);
+            ++count;
+        }
+
+        QCORO_COMPARE(count, 12);
+        QCORO_VERIFY(maxRunning <= 3);
+    }
+
+    QCoro::Task<> testParallelMapException_coro(QCoro::TestContext) {
+        auto generator = syncGenerator(10) | QCoro::parallelMap([](int value) {
+            if (value == 1) {
+                throw std::runtime_error("Parallel failure");
+            }
+            return value;
+        }, 2);
+
+        auto it = co_await generator.begin();
+        QCORO_COMPARE(*it, 0);
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await ++it, std::runtime_error);
+    }
+
+private Q_SLOTS:
+    addTest(MapFilterTake)
+    addTest(TakeStopsPulling)
+    addTest(TakeZero)
+    addTest(PipelineToGenerator)
+    addTest(Moveonly)
+    addTest(Chunk)
+    addTest(FusedChunk)
+    addTest(Merge)
+    addTest(MergeException)
+    addTest(DestroyMerge)
+    addTest(Window)
+    addTest(WindowMaxSize)
+    addTest(Zip)
+    addTest(StageException)
+    addTest(Prefetch)
+    addTest(PrefetchOverlap)
+    addTest(PrefetchException)
+    addTest(ParallelMapInputOrder)
+    addTest(ParallelMapCompletionOrder)
+    addTest(ParallelMapConcurrency)
+    addTest(ParallelMapException)
+};
+
+QTEST_GUILESS_MAIN(AsyncGeneratorOperatorsTest)
+
+#include "qcoroasyncgeneratoroperators.moc"
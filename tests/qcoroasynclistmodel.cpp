@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoroasynclistmodel.h"
+#include "qcorotimer.h"
+
+#include <QPointer>
+#include <QSignalSpy>
+#include <QTest>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+using namespace std::chrono_literals;
+
+//! Model with \c total rows, fetching each page with a small delay.
+class TestListModel : public QCoro::AsyncListModel {
+    Q_OBJECT
+public:
+    explicit TestListModel(int total)
+        : mTotal(total) {}
+
+    int fetchCount = 0;
+    int canceledCount = 0;
+    bool throwError = false;
+
+protected:
+    QCoro::Task<QVariantList> fetchPage(int offset, int count) override {
+        const auto fetch = currentFetch();
+        ++fetchCount;
+        QPointer<TestListModel> self(this);
+        co_await QCoro::sleepFor(10ms);
+        if (!self) {
+            co_return {};
+        }
+
+        if (isFetchCanceled(fetch)) {
+            ++canceledCount;
+            co_return {};
+        }
+        if (throwError) {
+            throw std::runtime_error("Failed to fetch");
+        }
+
+        QVariantList rows;
+        for (int i = offset; i < std::min(offset + count, mTotal); ++i) {
+            rows.push_back(i);
+        }
+        co_return rows;
+    }
+
+private:
+    int mTotal;
+};
+
+class QCoroAsyncListModelTest : public QObject {
+    Q_OBJECT
+private Q_SLOTS:
+    void testFetchMore() {
+        TestListModel model(100);
+        model.setPageSize(30);
+        model.setInsertBatchSize(10);
+        QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy finishedSpy(&model, &QCoro::AsyncListModel::fetchFinished);
+
+        QVERIFY(model.canFetchMore({}));
+        model.fetchMore({});
+        QVERIFY(model.isLoading());
+        QVERIFY(!model.canFetchMore({}));
+
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(finishedSpy.at(0).at(0).toInt(), 30);
+        QCOMPARE(model.rowCount(), 30);
+        // The rows are inserted in batches
+        QCOMPARE(insertedSpy.size(), 3);
+        QCOMPARE(model.data(model.index(29, 0)).toInt(), 29);
+        QVERIFY(!model.isLoading());
+        QVERIFY(model.canFetchMore({}));
+    }
+
+    void testCoalescing() {
+        TestListModel model(100);
+        QSignalSpy finishedSpy(&model, &QCoro::AsyncListModel::fetchFinished);
+
+        model.fetchMore({});
+        model.fetchMore({});
+        model.fetchNext();
+        QVERIFY(finishedSpy.wait());
+
+        QCOMPARE(model.fetchCount, 1);
+        QCOMPARE(model.rowCount(), 50);
+    }
+
+    void testAtEnd() {
+        TestListModel model(60);
+        QSignalSpy finishedSpy(&model, &QCoro::AsyncListModel::fetchFinished);
+        QSignalSpy atEndSpy(&model, &QCoro::AsyncListModel::atEndChanged);
+
+        model.fetchMore({});
+        QVERIFY(finishedSpy.wait());
+        QVERIFY(!model.atEnd());
+
+        model.fetchMore({});
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(model.rowCount(), 60);
+        QVERIFY(model.atEnd());
+        QCOMPARE(atEndSpy.size(), 1);
+        QVERIFY(!model.canFetchMore({}));
+    }
+
+    void testCancel() {
+        TestListModel model(100);
+        QSignalSpy finishedSpy(&model, &QCoro::AsyncListModel::fetchFinished);
+
+        model.fetchMore({});
+        model.cancelFetch();
+        QCOMPARE(finishedSpy.size(), 1);
+        QCOMPARE(finishedSpy.at(0).at(0).toInt(), 0);
+        QVERIFY(!model.isLoading());
+
+        QTRY_COMPARE(model.canceledCount, 1);
+        QCOMPARE(model.rowCount(), 0);
+        QVERIFY(model.canFetchMore({}));
+    }
+
+    void testCancelDuringReload() {
+        TestListModel model(100);
+        QSignalSpy finishedSpy(&model, &QCoro::AsyncListModel::fetchFinished);
+
+        // Both fetches start at offset 0, the first one must still see itself as canceled
+        model.fetchMore({});
+        model.reload();
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(finishedSpy.size(), 2);
+        QCOMPARE(finishedSpy.at(1).at(0).toInt(), 50);
+        QCOMPARE(model.fetchCount, 2);
+        QCOMPARE(model.canceledCount, 1);
+        QCOMPARE(model.rowCount(), 50);
+    }
+
+    void testDestroyWhileLoading() {
+        auto model = std::make_unique<TestListModel>(100);
+        bool signalEmitted = false;
+        connect(model.get(), &QCoro::AsyncListModel::loadingChanged, this, [&]() { signalEmitted = true; });
+        connect(model.get(), &QCoro::AsyncListModel::fetchFinished, this, [&]() { signalEmitted = true; });
+
+        model->fetchMore({});
+        QVERIFY(model->isLoading());
+        signalEmitted = false;
+        model.reset();
+        QVERIFY(!signalEmitted);
+    }
+
+    void testReload() {
+        TestListModel model(100);
+        QSignalSpy finishedSpy(&model, &QCoro::AsyncListModel::fetchFinished);
+        QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+
+        model.fetchMore({});
+        QVERIFY(finishedSpy.wait());
+        model.fetchMore({});
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(model.rowCount(), 100);
+
+        model.reload();
+        QCOMPARE(resetSpy.size(), 1);
+        QCOMPARE(model.rowCount(), 0);
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(model.rowCount(), 50);
+    }
+
+    void testError() {
+        TestListModel model(100);
+        model.throwError = true;
+        QSignalSpy errorSpy(&model, &QCoro::AsyncListModel::errorOccurred);
+
+        model.fetchMore({});
+        QVERIFY(errorSpy.wait());
+        QCOMPARE(errorSpy.at(0).at(0).toString(), QStringLiteral("Failed to fetch"));
+        QVERIFY(!model.canFetchMore({}));
+
+        model.throwError = false;
+        QSignalSpy finishedSpy(&model, &QCoro::AsyncListModel::fetchFinished);
+        model.reload();
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(model.rowCount(), 50);
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroAsyncListModelTest)
+
+#include "qcoroasynclistmodel.moc"
@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcorochannel.h"
+#include "qcorothread.h"
+#include "qcorotimer.h"
+
+#include <QScopeGuard>
+#include <QThread>
+
+#include <chrono>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+QCoro::Task<int> produce(QCoro::Channel<int> channel, int from, int count) {
+    int sent = 0;
+    for (int i = from; i < from + count; ++i) {
+        const bool ok = co_await channel.send(i);
+        if (!ok) {
+            break;
+        }
+        ++sent;
+    }
+    co_return sent;
+}
+
+QCoro::Task<std::vector<int>> consume(QCoro::Channel<int> channel) {
+    std::vector<int> received;
+    while (const auto value = co_await channel.receive()) {
+        received.push_back(*value);
+    }
+    co_return received;
+}
+
+} // namespace
+
+class QCoroChannelTest : public QCoro::TestObject<QCoroChannelTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testSendReceive_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(4);
+        QCORO_COMPARE(channel.capacity(), std::size_t{4});
+
+        auto consumer = consume(channel);
+        const auto sent = co_await produce(channel, 0, 100);
+        QCORO_COMPARE(sent, 100);
+        channel.close();
+
+        const auto received = co_await consumer;
+        std::vector<int> expected(100);
+        std::iota(expected.begin(), expected.end(), 0);
+        QCORO_COMPARE(received, expected);
+    }
+
+    QCoro::Task<> testBackpressure_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(2);
+        auto producer = produce(channel, 0, 3);
+        co_await QCoro::sleepFor(10ms);
+
+        // The third value is waiting for free space in the channel
+        QCORO_VERIFY(!producer.isReady());
+        QCORO_COMPARE(channel.size(), std::size_t{2});
+
+        const auto first = co_await channel.receive();
+        QCORO_VERIFY(first.has_value());
+        QCORO_COMPARE(*first, 0);
+        const auto sent = co_await producer;
+        QCORO_COMPARE(sent, 3);
+        QCORO_COMPARE(channel.size(), std::size_t{2});
+        QCORO_COMPARE(channel.tryReceive(), std::optional<int>{1});
+        QCORO_COMPARE(channel.tryReceive(), std::optional<int>{2});
+        QCORO_COMPARE(channel.tryReceive(), std::optional<int>{});
+    }
+
+    QCoro::Task<> testUnbuffered_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(0);
+        auto producer = produce(channel, 0, 1);
+        co_await QCoro::sleepFor(10ms);
+        QCORO_VERIFY(!producer.isReady());
+
+        const auto value = co_await channel.receive();
+        QCORO_COMPARE(value, std::optional<int>{0});
+        const auto sent = co_await producer;
+        QCORO_COMPARE(sent, 1);
+    }
+
+    QCoro::Task<> testClose_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(1);
+        auto producer = produce(channel, 0, 2);
+        co_await QCoro::sleepFor(10ms);
+
+        channel.close();
+        QCORO_VERIFY(channel.isClosed());
+        // The waiting send is resumed with false, the buffered value is kept
+        const auto sentBeforeClose = co_await producer;
+        QCORO_COMPARE(sentBeforeClose, 1);
+        const bool sent = co_await channel.send(42);
+        QCORO_VERIFY(!sent);
+
+        const auto buffered = co_await channel.receive();
+        QCORO_COMPARE(buffered, std::optional<int>{0});
+        const auto afterClose = co_await channel.receive();
+        QCORO_COMPARE(afterClose, std::optional<int>{});
+    }
+
+    QCoro::Task<> testCloseWakesReceivers_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(1);
+        auto consumer1 = consume(channel);
+        auto consumer2 = consume(channel);
+        co_await QCoro::sleepFor(10ms);
+
+        channel.close();
+        const auto received1 = co_await consumer1;
+        QCORO_VERIFY(received1.empty());
+        const auto received2 = co_await consumer2;
+        QCORO_VERIFY(received2.empty());
+    }
+
+    QCoro::Task<> testReceiveMany_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(10);
+        co_await produce(channel, 0, 5);
+
+        auto batch = co_await channel.receiveMany(3);
+        QCORO_COMPARE(batch, (std::vector<int>{0, 1, 2}));
+        batch = co_await channel.receiveMany(3);
+        QCORO_COMPARE(batch, (std::vector<int>{3, 4}));
+
+        auto producer = produce(channel, 5, 1);
+        batch = co_await channel.receiveMany(3);
+        QCORO_COMPARE(batch, (std::vector<int>{5}));
+        co_await producer;
+
+        channel.close();
+        batch = co_await channel.receiveMany(3);
+        QCORO_VERIFY(batch.empty());
+    }
+
+    QCoro::Task<> testSelect_coro(QCoro::TestContext) {
+        QCoro::Channel<int> numbers(1);
+        QCoro::Channel<std::string> strings(1);
+
+        auto sender = [](QCoro::Channel<std::string> channel) -> QCoro::Task<> {
+            co_await QCoro::sleepFor(10ms);
+            co_await channel.send("hello");
+        }(strings);
+        auto result = co_await QCoro::select(numbers, strings);
+        QCORO_COMPARE(result.index(), std::size_t{1});
+        QCORO_COMPARE(std::get<1>(result), std::optional<std::string>{"hello"});
+        co_await sender;
+
+        co_await numbers.send(42);
+        result = co_await QCoro::select(numbers, strings);
+        QCORO_COMPARE(result.index(), std::size_t{0});
+        QCORO_COMPARE(std::get<0>(result), std::optional<int>{42});
+
+        // The select is no longer waiting in the other channel
+        co_await strings.send("world");
+        QCORO_COMPARE(strings.tryReceive(), std::optional<std::string>{"world"});
+
+        strings.close();
+        result = co_await QCoro::select(numbers, strings);
+        QCORO_COMPARE(result.index(), std::size_t{1});
+        QCORO_COMPARE(std::get<1>(result), std::optional<std::string>{});
+    }
+
+    QCoro::Task<> testCrossThread_coro(QCoro::TestContext) {
+        QThread thread;
+        thread.start();
+        const auto threadGuard = qScopeGuard([&thread]() {
+            thread.quit();
+            thread.wait();
+        });
+
+        QCoro::Channel<int> channel(8);
+        auto *mainThread = QThread::currentThread();
+        auto producer = [](QCoro::Channel<int> channel, QThread *thread, QThread *mainThread) -> QCoro::Task<int> {
+            co_await QCoro::moveToThread(thread);
+            const auto sent = co_await produce(channel, 0, 1000);
+            channel.close();
+            // Finish in the main thread, so that the test is resumed there
+            co_await QCoro::moveToThread(mainThread);
+            co_return sent;
+        }(channel, &thread, mainThread);
+
+        long long sum = 0;
+        int count = 0;
+        while (const auto value = co_await channel.receive()) {
+            QCORO_COMPARE(QThread::currentThread(), mainThread);
+            sum += *value;
+            ++count;
+        }
+        QCORO_COMPARE(count, 1000);
+        QCORO_COMPARE(sum, 999LL * 1000 / 2);
+        const auto sent = co_await producer;
+        QCORO_COMPARE(sent, 1000);
+    }
+
+private Q_SLOTS:
+    addTest(SendReceive)
+    addTest(Backpressure)
+    addTest(Unbuffered)
+    addTest(Close)
+    addTest(CloseWakesReceivers)
+    addTest(ReceiveMany)
+    addTest(Select)
+    addTest(CrossThread)
+};
+
+QTEST_GUILESS_MAIN(QCoroChannelTest)
+
+#include "qcorochannel.moc"
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcorocoroutineregistry.h"
+#include "qcorotimer.h"
+
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+QCoro::Task<> waitForTimer(QTimer &timer) {
+    co_await timer;
+}
+
+QCoro::Task<> outer(QTimer &timer) {
+    co_await waitForTimer(timer);
+}
+
+QCoro::Task<> holdsFinishedChild(QTimer &childTimer, QTimer &timer) {
+    auto child = waitForTimer(childTimer);
+    co_await child;
+    co_await timer;
+}
+
+QCoro::Task<> finishedRightAway() {
+    co_return;
+}
+
+bool isCoroutine(const QCoro::CoroutineInfo &info, const char *name) {
+    return std::strstr(info.creationSite.functionName, name) != nullptr;
+}
+
+} // namespace
+
+class QCoroCoroutineRegistryTest : public QCoro::TestObject<QCoroCoroutineRegistryTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testAsyncStack_coro(QCoro::TestContext) {
+        if (!QCoro::CoroutineRegistry::isEnabled()) {
+            QCORO_SKIP("QCoro was built without the coroutine registry");
+        }
+
+        QTimer timer;
+        timer.setSingleShot(true);
+        timer.start(100ms);
+        auto task = outer(timer);
+        co_await QCoro::sleepFor(20ms);
+
+        const auto stacks = QCoro::CoroutineRegistry::asyncStacks();
+        const auto stack = std::find_if(stacks.cbegin(), stacks.cend(), [](const auto &stack) {
+            return isCoroutine(stack.front(), "waitForTimer");
+        });
+        QCORO_VERIFY(stack != stacks.cend());
+        // This test coroutine is not awaiting the task yet
+        QCORO_COMPARE(stack->size(), std::size_t{2});
+        QCORO_VERIFY(isCoroutine((*stack)[1], "outer"));
+
+        const auto &leaf = stack->front();
+        QCORO_VERIFY(leaf.state == QCoro::CoroutineInfo::State::Suspended);
+        QCORO_VERIFY(leaf.suspendedFor >= 15ms);
+        QCORO_VERIFY(leaf.suspensionPoint.line > 0);
+        QCORO_VERIFY(std::strstr(leaf.suspensionPoint.fileName, "qcorocoroutineregistry.cpp") != nullptr);
+        QCORO_VERIFY(leaf.awaitedType.find("QTimer") != std::string_view::npos);
+        QCORO_COMPARE(leaf.awaitedObject, static_cast<const void *>(&timer));
+        QCORO_VERIFY((*stack)[1].awaitedType.find("QCoro::Task") != std::string_view::npos);
+
+        co_await task;
+    }
+
+    QCoro::Task<> testFinishedCoroutineUnregistered_coro(QCoro::TestContext) {
+        if (!QCoro::CoroutineRegistry::isEnabled()) {
+            QCORO_SKIP("QCoro was built without the coroutine registry");
+        }
+
+        QTimer timer;
+        timer.setSingleShot(true);
+        timer.start(10ms);
+        {
+            auto task = waitForTimer(timer);
+            co_await task;
+        }
+
+        const auto coroutines = QCoro::CoroutineRegistry::coroutines();
+        QCORO_VERIFY(std::none_of(coroutines.cbegin(), coroutines.cend(), [](const auto &info) {
+            return isCoroutine(info, "waitForTimer");
+        }));
+    }
+
+    QCoro::Task<> testParentOfFinishedCoroutine_coro(QCoro::TestContext) {
+        if (!QCoro::CoroutineRegistry::isEnabled()) {
+            QCORO_SKIP("QCoro was built without the coroutine registry");
+        }
+
+        QTimer childTimer;
+        childTimer.setSingleShot(true);
+        childTimer.start(10ms);
+        QTimer timer;
+        timer.setSingleShot(true);
+        timer.start(100ms);
+        auto task = holdsFinishedChild(childTimer, timer);
+        co_await QCoro::sleepFor(50ms);
+
+        // The finished child must not hide the coroutine that has awaited it
+        const auto stacks = QCoro::CoroutineRegistry::asyncStacks();
+        const auto stack = std::find_if(stacks.cbegin(), stacks.cend(), [](const auto &stack) {
+            return isCoroutine(stack.front(), "holdsFinishedChild");
+        });
+        QCORO_VERIFY(stack != stacks.cend());
+        QCORO_COMPARE(stack->size(), std::size_t{1});
+        QCORO_VERIFY(stack->front().awaitedType.find("QTimer") != std::string_view::npos);
+
+        co_await task;
+    }
+
+private Q_SLOTS:
+    void testCoroutinesFromMultipleThreads() {
+        if (!QCoro::CoroutineRegistry::isEnabled()) {
+            QSKIP("QCoro was built without the coroutine registry");
+        }
+
+        const auto countFinished = []() {
+            const auto coroutines = QCoro::CoroutineRegistry::coroutines();
+            return static_cast<int>(std::count_if(coroutines.cbegin(), coroutines.cend(), [](const auto &info) {
+                return isCoroutine(info, "finishedRightAway");
+            }));
+        };
+
+        constexpr int threadCount = 4;
+        constexpr int tasksPerThread = 100;
+        std::vector<std::vector<QCoro::Task<>>> tasks(threadCount);
+        std::vector<std::thread> threads;
+        for (auto &threadTasks : tasks) {
+            threads.emplace_back([&threadTasks]() {
+                for (int i = 0; i < tasksPerThread; ++i) {
+                    threadTasks.push_back(finishedRightAway());
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        // Finished coroutines stay registered until the Task is destroyed
+        QCOMPARE(countFinished(), threadCount * tasksPerThread);
+
+        // Destroy the coroutines in a different thread than the one that created them
+        tasks.clear();
+        QCOMPARE(countFinished(), 0);
+    }
+
+    addTest(AsyncStack)
+    addTest(FinishedCoroutineUnregistered)
+    addTest(ParentOfFinishedCoroutine)
+};
+
+QTEST_GUILESS_MAIN(QCoroCoroutineRegistryTest)
+
+#include "qcorocoroutineregistry.moc"
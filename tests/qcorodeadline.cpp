@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcorodeadline.h"
+#include "qcorolazytask.h"
+#include "qcorosignal.h"
+#include "qcorotimer.h"
+
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+QCoro::Task<std::optional<std::chrono::milliseconds>> nestedRemainingTime() {
+    co_await QCoro::sleepFor(10ms);
+    co_return QCoro::remainingTime();
+}
+
+QCoro::LazyTask<std::optional<std::chrono::milliseconds>> lazyRemainingTime() {
+    co_return QCoro::remainingTime();
+}
+
+QCoro::Task<> tightenDeadline() {
+    co_await QCoro::setTimeout(10ms);
+    co_await QCoro::sleepFor(20ms);
+}
+
+} // namespace
+
+class QCoroDeadlineTest : public QCoro::TestObject<QCoroDeadlineTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testNoDeadline_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        QCORO_VERIFY(!QCoro::currentDeadline().has_value());
+        QCORO_VERIFY(!QCoro::remainingTime().has_value());
+        co_return;
+    }
+
+    QCoro::Task<> testSetDeadline_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        const auto deadline = std::chrono::steady_clock::now() + 1s;
+        co_await QCoro::setDeadline(deadline);
+        QCORO_VERIFY(QCoro::currentDeadline() == deadline);
+
+        // The deadline can only be tightened
+        co_await QCoro::setDeadline(deadline + 1s);
+        QCORO_VERIFY(QCoro::currentDeadline() == deadline);
+    }
+
+    QCoro::Task<> testNestedCoroutineInheritsDeadline_coro(QCoro::TestContext) {
+        co_await QCoro::setTimeout(1s);
+        const auto remaining = co_await nestedRemainingTime();
+        QCORO_VERIFY(remaining.has_value());
+        QCORO_VERIFY(*remaining <= 1s);
+    }
+
+    QCoro::Task<> testLazyTaskInheritsDeadline_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        co_await QCoro::setTimeout(1s);
+        // The deadline must be installed already when the body of the LazyTask starts running
+        const auto remaining = co_await lazyRemainingTime();
+        QCORO_VERIFY(remaining.has_value());
+        QCORO_VERIFY(*remaining <= 1s);
+    }
+
+    QCoro::Task<> testDeadlineRestoredOnSuspend_coro(QCoro::TestContext) {
+        co_await QCoro::setTimeout(1s);
+        const auto deadline = QCoro::currentDeadline();
+
+        // The nested coroutine tightens its own deadline, which must not leak into this coroutine
+        co_await tightenDeadline();
+        QCORO_VERIFY(QCoro::currentDeadline() == deadline);
+    }
+
+    QCoro::Task<> testSignalTimesOutAtDeadline_coro(QCoro::TestContext) {
+        co_await QCoro::setTimeout(50ms);
+
+        QTimer timer;
+        timer.setSingleShot(true);
+        timer.start(1s);
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        const auto result = co_await qCoro(&timer, &QTimer::timeout, 10s);
+        QCORO_VERIFY(!result.has_value());
+        QCORO_VERIFY(elapsed.elapsed() < 500);
+    }
+
+    QCoro::Task<> testSignalWithoutTimeoutIgnoresDeadline_coro(QCoro::TestContext) {
+        co_await QCoro::setTimeout(10ms);
+
+        QTimer timer;
+        timer.setSingleShot(true);
+        timer.start(50ms);
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        co_await qCoro(&timer, &QTimer::timeout);
+        QCORO_VERIFY(elapsed.elapsed() >= 40);
+    }
+
+private Q_SLOTS:
+    addTest(NoDeadline)
+    addTest(SetDeadline)
+    addTest(NestedCoroutineInheritsDeadline)
+    addTest(LazyTaskInheritsDeadline)
+    addTest(DeadlineRestoredOnSuspend)
+    addTest(SignalTimesOutAtDeadline)
+    addTest(SignalWithoutTimeoutIgnoresDeadline)
+
+    void testDeadlineNotLeakedToEventLoop() {
+        bool done = false;
+        [](bool &done) -> QCoro::Task<> {
+            co_await QCoro::setTimeout(1s);
+            co_await QCoro::sleepFor(10ms);
+            done = true;
+        }(done);
+        QVERIFY(!QCoro::currentDeadline().has_value());
+
+        QTRY_VERIFY(done);
+        QVERIFY(!QCoro::currentDeadline().has_value());
+    }
+
+    void testDeadlineScope() {
+        const auto deadline = std::chrono::steady_clock::now() + 1s;
+        std::optional<std::chrono::steady_clock::time_point> inherited;
+        {
+            QCoro::DeadlineScope scope(deadline);
+            QVERIFY(QCoro::currentDeadline() == deadline);
+            [](auto &inherited) -> QCoro::Task<> {
+                co_await QCoro::sleepFor(10ms);
+                inherited = QCoro::currentDeadline();
+            }(inherited);
+        }
+        QVERIFY(!QCoro::currentDeadline().has_value());
+
+        QTRY_VERIFY(inherited.has_value());
+        QVERIFY(*inherited == deadline);
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroDeadlineTest)
+
+#include "qcorodeadline.moc"
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcoroexpected.h"
+#include "qcoro/core/qcoroiodevice.h"
+#include "qcoro/core/qcorotimer.h"
+
+#include <QBuffer>
+#include <QString>
+
+#include <chrono>
+#include <memory>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+enum class ParseError {
+    Empty,
+    NotANumber,
+};
+
+QCoro::Task<QCoro::Expected<int, ParseError>> parse(QString input) {
+    co_await QCoro::sleepFor(1ms);
+    if (input.isEmpty()) {
+        co_return QCoro::Unexpected(ParseError::Empty);
+    }
+    bool ok = false;
+    const int value = input.toInt(&ok);
+    if (!ok) {
+        co_return QCoro::Unexpected(ParseError::NotANumber);
+    }
+    co_return value;
+}
+
+QCoro::Task<QCoro::Expected<int, ParseError>> sum(QString a, QString b, int &reached) {
+    QCORO_CO_TRY(first, parse(a));
+    ++reached;
+    QCORO_CO_TRY(second, parse(b));
+    ++reached;
+    co_return first + second;
+}
+
+QCoro::Task<QCoro::Expected<void, ParseError>> validate(QString input) {
+    QCORO_CO_TRYV(parse(input));
+    co_return {};
+}
+
+QCoro::Task<QCoro::Expected<int, ParseError>> validateIf(bool check, QString input) {
+    if (check)
+        QCORO_CO_TRYV(parse(input));
+    else
+        co_return -1;
+    co_return 1;
+}
+
+QCoro::Task<QCoro::Expected<int, ParseError>> sumOnOneLine(QString a, QString b) {
+    QCORO_CO_TRYV(parse(a)); QCORO_CO_TRYV(parse(b));
+    QCORO_CO_TRY(first, parse(a)); QCORO_CO_TRY(second, parse(b));
+    co_return first + second;
+}
+
+} // namespace
+
+class QCoroExpectedTest : public QCoro::TestObject<QCoroExpectedTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testPropagatesValue_coro(QCoro::TestContext) {
+        int reached = 0;
+        const auto result = co_await sum(QStringLiteral("1"), QStringLiteral("2"), reached);
+        QCORO_VERIFY(result.has_value());
+        QCORO_COMPARE(*result, 3);
+        QCORO_COMPARE(reached, 2);
+    }
+
+    QCoro::Task<> testPropagatesError_coro(QCoro::TestContext) {
+        int reached = 0;
+        const auto result = co_await sum(QStringLiteral("1"), QStringLiteral("x"), reached);
+        QCORO_VERIFY(!result.has_value());
+        QCORO_COMPARE(result.error(), ParseError::NotANumber);
+        QCORO_COMPARE(reached, 1);
+    }
+
+    QCoro::Task<> testShortCircuits_coro(QCoro::TestContext) {
+        int reached = 0;
+        const auto result = co_await sum(QString(), QStringLiteral("x"), reached);
+        QCORO_VERIFY(!result.has_value());
+        QCORO_COMPARE(result.error(), ParseError::Empty);
+        QCORO_COMPARE(reached, 0);
+    }
+
+    QCoro::Task<> testPropagatesVoid_coro(QCoro::TestContext) {
+        const auto valid = co_await validate(QStringLiteral("42"));
+        QCORO_VERIFY(valid.has_value());
+
+        const auto invalid = co_await validate(QStringLiteral("x"));
+        QCORO_VERIFY(!invalid.has_value());
+        QCORO_COMPARE(invalid.error(), ParseError::NotANumber);
+    }
+
+    QCoro::Task<> testUnbracedIf_coro(QCoro::TestContext) {
+        const auto unchecked = co_await validateIf(false, QStringLiteral("x"));
+        QCORO_VERIFY(unchecked.has_value());
+        QCORO_COMPARE(*unchecked, -1);
+
+        const auto valid = co_await validateIf(true, QStringLiteral("42"));
+        QCORO_VERIFY(valid.has_value());
+        QCORO_COMPARE(*valid, 1);
+
+        const auto invalid = co_await validateIf(true, QStringLiteral("x"));
+        QCORO_VERIFY(!invalid.has_value());
+        QCORO_COMPARE(invalid.error(), ParseError::NotANumber);
+    }
+
+    QCoro::Task<> testMultipleOnOneLine_coro(QCoro::TestContext) {
+        const auto valid = co_await sumOnOneLine(QStringLiteral("1"), QStringLiteral("2"));
+        QCORO_VERIFY(valid.has_value());
+        QCORO_COMPARE(*valid, 3);
+
+        const auto invalid = co_await sumOnOneLine(QStringLiteral("1"), QString());
+        QCORO_VERIFY(!invalid.has_value());
+        QCORO_COMPARE(invalid.error(), ParseError::Empty);
+    }
+
+    QCoro::Task<> testIODeviceNotReadable_coro(QCoro::TestContext) {
+        QBuffer buffer;
+        const auto result = co_await qCoro(buffer).tryReadAll();
+        QCORO_VERIFY(!result.has_value());
+        QCORO_COMPARE(result.error(), QCoro::IOError::NotReadable);
+    }
+
+    QCoro::Task<> testIODeviceRead_coro(QCoro::TestContext) {
+        QByteArray data{"first line\nsecond line\n"};
+        QBuffer buffer(&data);
+        QCORO_VERIFY(buffer.open(QIODevice::ReadOnly));
+
+        const auto line = co_await qCoro(buffer).tryReadLine();
+        QCORO_VERIFY(line.has_value());
+        QCORO_COMPARE(*line, QByteArray{"first line\n"});
+
+        const auto rest = co_await qCoro(buffer).tryReadAll();
+        QCORO_VERIFY(rest.has_value());
+        QCORO_COMPARE(*rest, QByteArray{"second line\n"});
+    }
+
+private Q_SLOTS:
+    void testValue() {
+        QCoro::Expected<QString, int> expected{QStringLiteral("value")};
+        QVERIFY(expected.has_value());
+        QVERIFY(static_cast<bool>(expected));
+        QCOMPARE(*expected, QStringLiteral("value"));
+        QCOMPARE(expected->size(), 5);
+        QCOMPARE(expected.value(), QStringLiteral("value"));
+        QCOMPARE(expected.value_or(QStringLiteral("default")), QStringLiteral("value"));
+    }
+
+    void testError() {
+        QCoro::Expected<QString, int> expected{QCoro::Unexpected(42)};
+        QVERIFY(!expected.has_value());
+        QCOMPARE(expected.error(), 42);
+        QCOMPARE(expected.value_or(QStringLiteral("default")), QStringLiteral("default"));
+        QVERIFY_EXCEPTION_THROWN(expected.value(), QCoro::BadExpectedAccess<int>);
+    }
+
+    void testSameValueAndErrorType() {
+        const QCoro::Expected<int, int> value{1};
+        const QCoro::Expected<int, int> error{QCoro::Unexpected(1)};
+        QVERIFY(value.has_value());
+        QVERIFY(!error.has_value());
+        QVERIFY(value != error);
+    }
+
+    void testMoveOnlyValue() {
+        QCoro::Expected<std::unique_ptr<int>, int> expected{std::make_unique<int>(42)};
+        const auto value = std::move(expected).value();
+        QCOMPARE(*value, 42);
+    }
+
+    void testVoid() {
+        const QCoro::Expected<void, int> success;
+        QVERIFY(success.has_value());
+        success.value();
+
+        const QCoro::Expected<void, int> failure{QCoro::Unexpected(42)};
+        QVERIFY(!failure.has_value());
+        QCOMPARE(failure.error(), 42);
+        QVERIFY_EXCEPTION_THROWN(failure.value(), QCoro::BadExpectedAccess<int>);
+    }
+
+    addTest(PropagatesValue)
+    addTest(PropagatesError)
+    addTest(ShortCircuits)
+    addTest(PropagatesVoid)
+    addTest(UnbracedIf)
+    addTest(MultipleOnOneLine)
+    addTest(IODeviceNotReadable)
+    addTest(IODeviceRead)
+};
+
+QTEST_GUILESS_MAIN(QCoroExpectedTest)
+
+#include "qcoroexpected.moc"
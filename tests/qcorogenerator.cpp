@@ -9,6 +9,10 @@
 #include <QTest>
 #include <QScopeGuard>
 
+#include <memory>
+#include <ranges>
+#include <vector>
+
 struct Nocopymove {
     explicit constexpr Nocopymove(int val): val(val) {}
     Nocopymove(const Nocopymove &) = delete;
@@ -31,6 +35,43 @@ struct Moveonly {
     int val;
 };
 
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(int *allocations): allocations(allocations) {}
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U> &other): allocations(other.allocations) {} // NOLINT(google-explicit-constructor)
+
+    T *allocate(std::size_t n) {
+        ++*allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T *ptr, std::size_t n) {
+        --*allocations;
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    bool operator==(const CountingAllocator &) const = default;
+
+    int *allocations;
+};
+
+struct Multiplier {
+    template<typename Alloc>
+    QCoro::Generator<int> multiples(std::allocator_arg_t, const Alloc &, int count) {
+        for (int i = 0; i < count; ++i) {
+            co_yield i * factor;
+        }
+    }
+
+    int factor;
+};
+
+static_assert(std::input_iterator<QCoro::GeneratorIterator<int>>);
+static_assert(std::ranges::input_range<QCoro::Generator<const Nocopymove &>>);
+static_assert(std::ranges::view<QCoro::Generator<int>>);
+
 class GeneratorTest : public QObject {
     Q_OBJECT
 private Q_SLOTS:
@@ -196,6 +237,58 @@ private Q_SLOTS:
 
         QVERIFY_THROWS_EXCEPTION(std::runtime_error, generator.begin());
     }
+
+    void testCustomAllocator() {
+        const auto createGenerator = [](std::allocator_arg_t, const CountingAllocator<int> &, int count) -> QCoro::Generator<int> {
+            for (int i = 0; i < count; ++i) {
+                co_yield i;
+            }
+        };
+
+        int allocations = 0;
+        std::vector<int> values;
+        {
+            auto generator = createGenerator(std::allocator_arg, CountingAllocator<int>(&allocations), 3);
+            QCOMPARE(allocations, 1);
+            for (int value : generator) {
+                values.push_back(value);
+            }
+        }
+
+        QCOMPARE(allocations, 0);
+        QCOMPARE(values, (std::vector<int>{0, 1, 2}));
+    }
+
+    void testMemberFunctionAllocator() {
+        int allocations = 0;
+        Multiplier multiplier{3};
+        std::vector<int> values;
+        for (int value : multiplier.multiples(std::allocator_arg, CountingAllocator<char>(&allocations), 3)) {
+            QCOMPARE(allocations, 1);
+            values.push_back(value);
+        }
+
+        QCOMPARE(allocations, 0);
+        QCOMPARE(values, (std::vector<int>{0, 3, 6}));
+    }
+
+    void testRanges() {
+        const auto createGenerator = []() -> QCoro::Generator<int> {
+            for (int i = 0;; ++i) {
+                co_yield i;
+            }
+        };
+
+        std::vector<int> values;
+        for (int value : createGenerator()
+                            | std::views::filter([](int value) { return value % 2 == 0; })
+                            | std::views::transform([](int value) { return value * 10; })
+                            | std::views::take(3)) {
+            values.push_back(value);
+        }
+
+        QCOMPARE(values, (std::vector<int>{0, 20, 40}));
+    }
 };
 
 QTEST_GUILESS_MAIN(GeneratorTest)
@@ -6,7 +6,9 @@
 #include "qcoro/core/qcorotimer.h"
 #include "qcoro/quick/qcoroimageprovider.h"
 
+#include <QBuffer>
 #include <QQmlEngine>
+#include <QSignalSpy>
 #include <QQmlComponent>
 #include <QQuickItem>
 
@@ -14,6 +16,8 @@
 #include <private/qquickimage_p.h>
 #undef emit
 
+#include <memory>
+
 class TestImageProvider final: public QCoro::ImageProvider {
 public:
     TestImageProvider(bool async, const QString &error)
@@ -39,6 +43,90 @@ private:
     QString mError;
 };
 
+//! Image provider that counts the requests and decodes a generated image.
+class CountingImageProvider final : public QCoro::ImageProvider {
+public:
+    QCoro::Task<QImage> asyncRequestImage(const QString &id, const QSize &requestedSize) override {
+        ++requestCount;
+
+        QTimer timer;
+        timer.start(50ms);
+        co_await timer;
+
+        if (isRequestCanceled(id, requestedSize)) {
+            ++canceledCount;
+            co_return QImage{};
+        }
+
+        QImage image(200, 100, QImage::Format_RGB32);
+        image.fill(Qt::red);
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, "PNG");
+
+        co_return co_await decodeImage(data, requestedSize);
+    }
+
+    std::unique_ptr<QQuickImageResponse> request(const QString &id, const QSize &requestedSize = {}) {
+        return std::unique_ptr<QQuickImageResponse>(
+            static_cast<QQuickAsyncImageProvider *>(this)->requestImageResponse(id, requestedSize));
+    }
+
+    int requestCount = 0;
+    int canceledCount = 0;
+};
+
+//! Texture factory that doesn't need any image data.
+class TestTextureFactory final : public QQuickTextureFactory {
+public:
+    explicit TestTextureFactory(int *destroyedCount)
+        : mDestroyedCount(destroyedCount) {}
+    ~TestTextureFactory() override {
+        ++*mDestroyedCount;
+    }
+
+    QSGTexture *createTexture(QQuickWindow *) const override {
+        return nullptr;
+    }
+    QSize textureSize() const override {
+        return QSize(64, 32);
+    }
+    int textureByteCount() const override {
+        return 64 * 32 * 4;
+    }
+
+private:
+    int *mDestroyedCount;
+};
+
+//! Image provider that provides texture factories instead of images.
+class TextureImageProvider final : public QCoro::ImageProvider {
+public:
+    QCoro::Task<std::unique_ptr<QQuickTextureFactory>> asyncRequestTexture(const QString &, const QSize &) override {
+        ++requestCount;
+
+        QTimer timer;
+        timer.start(50ms);
+        co_await timer;
+
+        co_return std::make_unique<TestTextureFactory>(&destroyedCount);
+    }
+
+    std::unique_ptr<QQuickImageResponse> request(const QString &id, const QSize &requestedSize = {}) {
+        return std::unique_ptr<QQuickImageResponse>(
+            static_cast<QQuickAsyncImageProvider *>(this)->requestImageResponse(id, requestedSize));
+    }
+
+    int requestCount = 0;
+    int destroyedCount = 0;
+};
+
+QImage responseImage(QQuickImageResponse *response) {
+    std::unique_ptr<QQuickTextureFactory> factory(response->textureFactory());
+    return factory->image();
+}
+
 class QCoroImageProviderTest: public QCoro::TestObject<QCoroImageProviderTest> {
     Q_OBJECT
 
@@ -94,6 +182,104 @@ Image {
         }
     }
 
+    void testCoalescing() {
+        CountingImageProvider provider;
+        auto first = provider.request(QStringLiteral("image"));
+        auto second = provider.request(QStringLiteral("image"));
+        auto other = provider.request(QStringLiteral("image"), QSize(100, 100));
+
+        QSignalSpy firstSpy(first.get(), &QQuickImageResponse::finished);
+        QSignalSpy secondSpy(second.get(), &QQuickImageResponse::finished);
+        QSignalSpy otherSpy(other.get(), &QQuickImageResponse::finished);
+        QVERIFY(firstSpy.wait());
+        QTRY_COMPARE(secondSpy.size(), 1);
+        QTRY_COMPARE(otherSpy.size(), 1);
+
+        QCOMPARE(provider.requestCount, 2);
+        QCOMPARE(responseImage(first.get()).size(), QSize(200, 100));
+        QCOMPARE(responseImage(second.get()).size(), QSize(200, 100));
+        QCOMPARE(responseImage(other.get()).size(), QSize(100, 50));
+    }
+
+    void testCache() {
+        CountingImageProvider provider;
+        provider.setCacheCapacity(1024 * 1024);
+
+        auto first = provider.request(QStringLiteral("image"));
+        QSignalSpy firstSpy(first.get(), &QQuickImageResponse::finished);
+        QVERIFY(firstSpy.wait());
+
+        auto second = provider.request(QStringLiteral("image"));
+        QCOMPARE(responseImage(second.get()).size(), QSize(200, 100));
+        QCOMPARE(provider.requestCount, 1);
+
+        provider.clearCache();
+        auto third = provider.request(QStringLiteral("image"));
+        QSignalSpy thirdSpy(third.get(), &QQuickImageResponse::finished);
+        QVERIFY(thirdSpy.wait());
+        QCOMPARE(provider.requestCount, 2);
+    }
+
+    void testCacheDisabled() {
+        CountingImageProvider provider;
+
+        auto first = provider.request(QStringLiteral("image"));
+        QSignalSpy firstSpy(first.get(), &QQuickImageResponse::finished);
+        QVERIFY(firstSpy.wait());
+
+        auto second = provider.request(QStringLiteral("image"));
+        QSignalSpy secondSpy(second.get(), &QQuickImageResponse::finished);
+        QVERIFY(secondSpy.wait());
+        QCOMPARE(provider.requestCount, 2);
+    }
+
+    void testCancel() {
+        CountingImageProvider provider;
+        auto first = provider.request(QStringLiteral("image"));
+        auto second = provider.request(QStringLiteral("image"));
+        QSignalSpy firstSpy(first.get(), &QQuickImageResponse::finished);
+        QSignalSpy secondSpy(second.get(), &QQuickImageResponse::finished);
+
+        first->cancel();
+        QVERIFY(firstSpy.wait());
+        QCOMPARE(provider.requestCount, 1);
+
+        second->cancel();
+        QVERIFY(secondSpy.wait());
+
+        // The image is not decoded once all the requests are canceled
+        QTRY_COMPARE(provider.canceledCount, 1);
+        QCOMPARE(firstSpy.size(), 1);
+        QCOMPARE(secondSpy.size(), 1);
+    }
+
+    void testTextureFactory() {
+        TextureImageProvider provider;
+        auto first = provider.request(QStringLiteral("texture"));
+        auto second = provider.request(QStringLiteral("texture"));
+        QSignalSpy firstSpy(first.get(), &QQuickImageResponse::finished);
+        QSignalSpy secondSpy(second.get(), &QQuickImageResponse::finished);
+        QVERIFY(firstSpy.wait());
+        QTRY_COMPARE(secondSpy.size(), 1);
+        QCOMPARE(provider.requestCount, 1);
+
+        // Ownership of the factory is handed over to the caller only once
+        std::unique_ptr<QQuickTextureFactory> firstFactory(first->textureFactory());
+        QVERIFY(firstFactory != nullptr);
+        QCOMPARE(first->textureFactory(), nullptr);
+        QCOMPARE(firstFactory->textureSize(), QSize(64, 32));
+        QCOMPARE(firstFactory->textureByteCount(), 64 * 32 * 4);
+
+        // Both responses share the same texture, which is destroyed with the last response
+        std::unique_ptr<QQuickTextureFactory> secondFactory(second->textureFactory());
+        QVERIFY(secondFactory != nullptr);
+        firstFactory.reset();
+        first.reset();
+        QCOMPARE(provider.destroyedCount, 0);
+        secondFactory.reset();
+        QCOMPARE(provider.destroyedCount, 1);
+    }
+
 private:
 };
 
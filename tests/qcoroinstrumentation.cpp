@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcoroinstrumentation.h"
+#include "qcorotimer.h"
+
+#include <QTimer>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+QCORO_INSTRUMENT_ALLOCATIONS()
+
+namespace {
+
+using Payload = std::array<char, 256>;
+
+//! Allocates while suspending the awaiting coroutine, like e.g. connecting to a signal does.
+struct AllocatingAwaitable {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+        payload = std::make_unique<Payload>();
+        QTimer::singleShot(0, [awaitingCoroutine]() { awaitingCoroutine.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+    std::unique_ptr<Payload> payload;
+};
+
+QCoro::Task<> allocator() {
+    co_await AllocatingAwaitable{};
+}
+
+QCoro::Task<> sleeper() {
+    co_await QCoro::sleepFor(50ms);
+    co_await QCoro::sleepFor(10ms);
+}
+
+quint64 totalAwaits(const QCoro::InstrumentationStats &stats) {
+    quint64 awaits = 0;
+    for (const auto &coroutine : stats.coroutines) {
+        awaits += coroutine.awaits;
+    }
+    return awaits;
+}
+
+} // namespace
+
+class QCoroInstrumentationTest : public QCoro::TestObject<QCoroInstrumentationTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testFrameCounts_coro(QCoro::TestContext) {
+        if (!QCoro::Instrumentation::isEnabled()) {
+            QCORO_SKIP("QCoro was built without instrumentation");
+        }
+
+        QCoro::Instrumentation::reset();
+        const auto before = QCoro::Instrumentation::stats();
+
+        std::vector<QCoro::Task<>> tasks;
+        for (int i = 0; i < 10; ++i) {
+            tasks.push_back(sleeper());
+        }
+
+        const auto during = QCoro::Instrumentation::stats();
+        QCORO_VERIFY(during.liveFrames >= before.liveFrames + 10);
+        QCORO_VERIFY(during.liveFrameBytes > before.liveFrameBytes);
+        QCORO_VERIFY(during.peakFrameBytes >= during.liveFrameBytes);
+        QCORO_VERIFY(std::any_of(during.coroutines.cbegin(), during.coroutines.cend(), [](const auto &coroutine) {
+            return coroutine.live >= 10 && coroutine.peakLive >= 10 && coroutine.frameSize > 0;
+        }));
+
+        for (auto &task : tasks) {
+            co_await task;
+        }
+        tasks.clear();
+
+        const auto after = QCoro::Instrumentation::stats();
+        QCORO_COMPARE(after.liveFrames, during.liveFrames - 10);
+        QCORO_VERIFY(after.createdFrames >= 10);
+        // Each sleeper awaits twice
+        QCORO_VERIFY(totalAwaits(after) >= 20);
+    }
+
+    QCoro::Task<> testReset_coro(QCoro::TestContext) {
+        if (!QCoro::Instrumentation::isEnabled()) {
+            QCORO_SKIP("QCoro was built without instrumentation");
+        }
+
+        co_await sleeper();
+        QCoro::Instrumentation::reset();
+
+        const auto stats = QCoro::Instrumentation::stats();
+        QCORO_COMPARE(stats.createdFrames, quint64{0});
+        QCORO_COMPARE(stats.peakFrameBytes, stats.liveFrameBytes);
+        QCORO_COMPARE(totalAwaits(stats), quint64{0});
+    }
+
+    QCoro::Task<> testAllocationsWhileSuspending_coro(QCoro::TestContext) {
+        if (!QCoro::Instrumentation::isEnabled()) {
+            QCORO_SKIP("QCoro was built without instrumentation");
+        }
+
+        QCoro::Instrumentation::reset();
+        co_await allocator();
+
+        // Only the allocator() frame was created since the reset
+        const auto stats = QCoro::Instrumentation::stats();
+        QCORO_VERIFY(stats.allocatedBytes >= sizeof(Payload));
+        QCORO_VERIFY(std::any_of(stats.coroutines.cbegin(), stats.coroutines.cend(), [](const auto &coroutine) {
+            return coroutine.created == 1 && coroutine.allocatedBytes >= sizeof(Payload);
+        }));
+    }
+
+private Q_SLOTS:
+    addTest(FrameCounts)
+    addTest(Reset)
+    addTest(AllocationsWhileSuspending)
+};
+
+QTEST_GUILESS_MAIN(QCoroInstrumentationTest)
+
+#include "qcoroinstrumentation.moc"
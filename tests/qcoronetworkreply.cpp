@@ -181,6 +181,35 @@ private:
         // crash (or cause invalid memory access)
     }
 
+    QCoro::Task<> testTryWaitForFinished_coro(QCoro::TestContext) {
+        QNetworkAccessManager nam;
+        auto reply = std::unique_ptr<QNetworkReply>(nam.get(buildRequest()));
+
+        const auto result = co_await qCoro(reply.get()).tryWaitForFinished();
+
+        QCORO_VERIFY(result.has_value());
+        QCORO_COMPARE(reply->readAll(), "abcdef");
+    }
+
+    QCoro::Task<> testTryWaitForFinishedError_coro(QCoro::TestContext) {
+        mServer.setExpectTimeout(true); // the request goes to a different port
+
+        // Find a port that no-one is listening on
+        QTcpServer closedServer;
+        QCORO_VERIFY(closedServer.listen(QHostAddress::LocalHost));
+        const auto closedPort = closedServer.serverPort();
+        closedServer.close();
+
+        QNetworkAccessManager nam;
+        auto reply = std::unique_ptr<QNetworkReply>(
+            nam.get(QNetworkRequest{QUrl{QStringLiteral("http://127.0.0.1:%1/").arg(closedPort)}}));
+
+        const auto result = co_await qCoro(reply.get()).tryWaitForFinished();
+
+        QCORO_VERIFY(!result.has_value());
+        QCORO_COMPARE(result.error(), QNetworkReply::ConnectionRefusedError);
+    }
+
 private Q_SLOTS:
     void init() {
         mServer.start(QHostAddress::LocalHost);
@@ -199,6 +228,8 @@ private Q_SLOTS:
     addCoroAndThenTests(ReadTriggers)
     addCoroAndThenTests(ReadLineTriggers)
     addTest(AbortOnTimeout)
+    addTest(TryWaitForFinished)
+    addTest(TryWaitForFinishedError)
 
 private:
     QNetworkRequest buildRequest(const QString &path = QString()) {
@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcoropromise.h"
+#include "qcorotimer.h"
+
+#include <QRegularExpression>
+#include <QScopeGuard>
+#include <QThread>
+#include <QTimer>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class TestException : public std::runtime_error {
+public:
+    explicit TestException()
+        : std::runtime_error("TestException") {}
+};
+
+} // namespace
+
+class QCoroPromiseTest : public QCoro::TestObject<QCoroPromiseTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testSetValue_coro(QCoro::TestContext) {
+        QCoro::Promise<int> promise;
+        QTimer::singleShot(10ms, this, [promise]() { promise.setValue(42); });
+
+        const auto value = co_await promise.task();
+        QCORO_COMPARE(value, 42);
+        QCORO_VERIFY(promise.isResolved());
+    }
+
+    QCoro::Task<> testSetValueBeforeAwait_coro(QCoro::TestContext) {
+        QCoro::Promise<QString> promise;
+        QCORO_VERIFY(promise.setValue(QStringLiteral("ready")));
+
+        const auto value = co_await promise.task();
+        QCORO_COMPARE(value, QStringLiteral("ready"));
+    }
+
+    QCoro::Task<> testVoid_coro(QCoro::TestContext) {
+        QCoro::Promise<> promise;
+        bool resolved = false;
+        QTimer::singleShot(10ms, this, [promise, &resolved]() { resolved = promise.setValue(); });
+
+        co_await promise.task();
+        QCORO_VERIFY(resolved);
+    }
+
+    QCoro::Task<> testMoveOnlyValue_coro(QCoro::TestContext) {
+        QCoro::Promise<std::unique_ptr<int>> promise;
+        QTimer::singleShot(10ms, this, [promise]() { promise.setValue(std::make_unique<int>(42)); });
+
+        const auto value = co_await promise.task();
+        QCORO_VERIFY(value != nullptr);
+        QCORO_COMPARE(*value, 42);
+    }
+
+    QCoro::Task<> testSetException_coro(QCoro::TestContext) {
+        QCoro::Promise<int> promise;
+        QTimer::singleShot(10ms, this, [promise]() { promise.setException(std::make_exception_ptr(TestException())); });
+
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await promise.task(), TestException);
+    }
+
+    QCoro::Task<> testResolvedOnlyOnce_coro(QCoro::TestContext) {
+        QCoro::Promise<int> promise;
+        QCORO_VERIFY(!promise.isResolved());
+        QCORO_VERIFY(promise.setValue(1));
+        QCORO_VERIFY(!promise.setValue(2));
+        QCORO_VERIFY(!promise.setException(std::make_exception_ptr(TestException())));
+
+        const auto value = co_await promise.task();
+        QCORO_COMPARE(value, 1);
+    }
+
+    QCoro::Task<> testBrokenPromise_coro(QCoro::TestContext) {
+        auto task = [this]() {
+            QCoro::Promise<int> promise;
+            // The callback is destroyed without ever resolving the promise
+            QTimer::singleShot(10ms, this, [promise]() {});
+            return promise.task();
+        }();
+
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await task, std::future_error);
+    }
+
+    QCoro::Task<> testResolveFromThread_coro(QCoro::TestContext) {
+        QCoro::Promise<int> promise;
+        auto *mainThread = QThread::currentThread();
+        std::unique_ptr<QThread> thread(QThread::create([promise]() {
+            QThread::msleep(10);
+            promise.setValue(42);
+        }));
+        thread->start();
+        const auto threadGuard = qScopeGuard([&thread]() { thread->wait(); });
+
+        const auto value = co_await promise.task();
+        QCORO_COMPARE(value, 42);
+        // The coroutine is resumed in the thread it has suspended in
+        QCORO_COMPARE(QThread::currentThread(), mainThread);
+    }
+
+    QCoro::Task<> testResolveFromThreadRace_coro(QCoro::TestContext) {
+        for (int i = 0; i < 1000; ++i) {
+            QCoro::Promise<int> promise;
+            auto task = promise.task();
+            std::unique_ptr<QThread> thread(QThread::create([promise, i]() { promise.setValue(i); }));
+            thread->start();
+
+            const auto value = co_await task;
+            QCORO_COMPARE(value, i);
+            thread->wait();
+        }
+    }
+
+private Q_SLOTS:
+    void testTaskRetrievedOnlyOnce() {
+        QCoro::Promise<int> promise;
+        const auto copy = promise;
+        auto task = promise.task();
+
+        try {
+            copy.task();
+            QFAIL("Retrieving the task twice didn't throw");
+        } catch (const std::future_error &error) {
+            QVERIFY(error.code() == std::future_errc::future_already_retrieved);
+        }
+
+        // The task retrieved first is not affected
+        promise.setValue(42);
+        QCOMPARE(QCoro::waitFor(std::move(task)), 42);
+    }
+
+    void testAwaitInThreadWithoutEventLoop() {
+        QCoro::Promise<int> promise;
+        std::optional<int> value;
+        QThread *resumedIn = nullptr;
+        std::promise<void> suspended;
+        std::promise<void> release;
+
+        // A plain std::thread has no event dispatcher
+        std::thread thread([&]() {
+            [](QCoro::Task<int> task, std::optional<int> &value, QThread *&resumedIn) -> QCoro::Task<> {
+                value = co_await task;
+                resumedIn = QThread::currentThread();
+            }(promise.task(), value, resumedIn);
+            suspended.set_value();
+            release.get_future().wait();
+        });
+        const auto threadGuard = qScopeGuard([&]() {
+            release.set_value();
+            thread.join();
+        });
+        suspended.get_future().wait();
+
+        // The coroutine can't be resumed in its thread, so it's resumed here with a warning
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("which has no event dispatcher")));
+        promise.setValue(42);
+        QVERIFY(value.has_value());
+        QCOMPARE(*value, 42);
+        QCOMPARE(resumedIn, QThread::currentThread());
+    }
+
+    addTest(SetValue)
+    addTest(SetValueBeforeAwait)
+    addTest(Void)
+    addTest(MoveOnlyValue)
+    addTest(SetException)
+    addTest(ResolvedOnlyOnce)
+    addTest(BrokenPromise)
+    addTest(ResolveFromThread)
+    addTest(ResolveFromThreadRace)
+};
+
+QTEST_GUILESS_MAIN(QCoroPromiseTest)
+
+#include "qcoropromise.moc"
@@ -10,10 +10,13 @@
 
 #include <QTest>
 #include <QTimer>
+#include <QJSEngine>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
 
 #include <chrono>
+#include <memory>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -131,6 +134,88 @@ QtObject {
             QCoreApplication::processEvents();
         }
     }
+
+    Q_SLOT void testAwaitBatched() {
+        QTimer timer;
+        timer.setSingleShot(true);
+
+        std::vector<QCoro::QmlTaskListener *> listeners;
+        int updated = 0;
+        for (int i = 0; i < 100; ++i) {
+            QCoro::QmlTask task([](QTimer *timer, int i) -> QCoro::Task<int> {
+                co_await timer;
+                co_return i;
+            }(&timer, i));
+            auto *listener = task.await();
+            QCOMPARE(task.await(), listener);
+            connect(listener, &QCoro::QmlTaskListener::valueChanged, this, [&updated]() { ++updated; });
+            listeners.push_back(listener);
+        }
+
+        // All the tasks have finished by now, but the results are delivered in the next event loop iteration
+        int updatedOnTimeout = -1;
+        connect(&timer, &QTimer::timeout, this, [&]() { updatedOnTimeout = updated; });
+        timer.start(10ms);
+
+        QTRY_COMPARE(updated, 100);
+        QCOMPARE(updatedOnTimeout, 0);
+        for (int i = 0; i < 100; ++i) {
+            QCOMPARE(listeners[i]->value().toInt(), i);
+        }
+        qDeleteAll(listeners);
+    }
+
+    Q_SLOT void testAwaitRepeatedIntermediateValue() {
+        QTimer timer;
+        timer.setSingleShot(true);
+        QCoro::QmlTask task([](QTimer *timer) -> QCoro::Task<QString> {
+            co_await timer;
+            co_return QStringLiteral("Result");
+        }(&timer));
+
+        std::unique_ptr<QCoro::QmlTaskListener> listener(task.await(QStringLiteral("Loading...")));
+        QCOMPARE(listener->value().toString(), QStringLiteral("Loading..."));
+        QCOMPARE(task.await(QStringLiteral("Still loading...")), listener.get());
+        QCOMPARE(listener->value().toString(), QStringLiteral("Still loading..."));
+
+        timer.start(10ms);
+        QTRY_COMPARE(listener->value().toString(), QStringLiteral("Result"));
+
+        // The result is not replaced by an intermediate value
+        QCOMPARE(task.await(QStringLiteral("Loading...")), listener.get());
+        QCOMPARE(listener->value().toString(), QStringLiteral("Result"));
+    }
+
+    Q_SLOT void testAwaitFinishedTask() {
+        QCoro::QmlTask task([]() -> QCoro::Task<int> { co_return 42; }());
+        std::unique_ptr<QCoro::QmlTaskListener> listener(task.await());
+        QCOMPARE(listener->value().toInt(), 42);
+    }
+
+    Q_SLOT void testThenAfterEngineDestroyed() {
+        auto engine = std::make_unique<QJSEngine>();
+        QTimer timer;
+        timer.setSingleShot(true);
+        {
+            QCoro::QmlTask task([](QTimer *timer) -> QCoro::Task<int> {
+                co_await timer;
+                co_return 42;
+            }(&timer));
+            task.then(engine->evaluate(QStringLiteral("(function(value) {})")));
+        }
+
+        // Destroy the engine after the task has finished, but before the callback is delivered
+        bool destroyed = false;
+        connect(&timer, &QTimer::timeout, this, [&]() {
+            engine.reset();
+            destroyed = true;
+        });
+        timer.start(10ms);
+
+        QTRY_VERIFY(destroyed);
+        // Give the dispatcher a chance to deliver the dropped callback
+        QTest::qWait(10);
+    }
 };
 
 QTEST_GUILESS_MAIN(QCoroQmlTaskTest)
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcororatelimit.h"
+#include "qcorotimer.h"
+
+#include <QElapsedTimer>
+
+#include <chrono>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class QCoroRateLimitTest : public QCoro::TestObject<QCoroRateLimitTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testDebounce_coro(QCoro::TestContext) {
+        QCoro::Debouncer debouncer(50ms);
+        std::vector<int> passed;
+        const auto call = [&](int value) -> QCoro::Task<> {
+            const bool latest = co_await debouncer.debounce();
+            if (latest) {
+                passed.push_back(value);
+            }
+        };
+
+        std::vector<QCoro::Task<>> calls;
+        for (int i = 0; i < 5; ++i) {
+            calls.push_back(call(i));
+            co_await QCoro::sleepFor(10ms);
+        }
+        for (auto &task : calls) {
+            co_await task;
+        }
+
+        QCORO_COMPARE(passed, std::vector<int>{4});
+    }
+
+    QCoro::Task<> testThrottle_coro(QCoro::TestContext) {
+        QCoro::Throttler throttler(100ms);
+        std::vector<int> passed;
+        const auto call = [&](int value) -> QCoro::Task<> {
+            const bool letThrough = co_await throttler.throttle();
+            if (letThrough) {
+                passed.push_back(value);
+            }
+        };
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        std::vector<QCoro::Task<>> calls;
+        for (int i = 0; i < 5; ++i) {
+            calls.push_back(call(i));
+        }
+        // The first call is let through immediately
+        QCORO_COMPARE(passed, std::vector<int>{0});
+
+        for (auto &task : calls) {
+            co_await task;
+        }
+        // Only the last call is let through once the interval passes
+        QCORO_COMPARE(passed, (std::vector<int>{0, 4}));
+        QCORO_VERIFY(elapsed.elapsed() >= 75);
+    }
+
+    QCoro::Task<> testRateLimiterBurst_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        QCoro::RateLimiter limiter(3, 1s);
+        co_await limiter.acquire();
+        co_await limiter.acquire();
+        QCORO_VERIFY(limiter.tryAcquire());
+        QCORO_VERIFY(!limiter.tryAcquire());
+    }
+
+    QCoro::Task<> testRateLimiterRate_coro(QCoro::TestContext) {
+        QCoro::RateLimiter limiter(10, 500ms, 1);
+        std::vector<int> order;
+        const auto acquire = [&](int value) -> QCoro::Task<> {
+            co_await limiter.acquire();
+            order.push_back(value);
+        };
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        std::vector<QCoro::Task<>> calls;
+        for (int i = 0; i < 5; ++i) {
+            calls.push_back(acquire(i));
+        }
+        for (auto &task : calls) {
+            co_await task;
+        }
+
+        // One permit every 50ms, the first one right away
+        QCORO_VERIFY(elapsed.elapsed() >= 175);
+        QCORO_COMPARE(order, (std::vector<int>{0, 1, 2, 3, 4}));
+    }
+
+private Q_SLOTS:
+    addTest(Debounce)
+    addTest(Throttle)
+    addTest(RateLimiterBurst)
+    addTest(RateLimiterRate)
+};
+
+QTEST_GUILESS_MAIN(QCoroRateLimitTest)
+
+#include "qcororatelimit.moc"
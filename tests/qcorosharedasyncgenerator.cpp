@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorosharedasyncgenerator.h"
+#include "qcorotimer.h"
+#include "testobject.h"
+
+#include <QScopeGuard>
+
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+QCoro::AsyncGenerator<int> syncGenerator(int count, int *produced = nullptr) {
+    for (int i = 0; i < count; ++i) {
+        if (produced) {
+            ++*produced;
+        }
+        co_yield i;
+    }
+}
+
+QCoro::AsyncGenerator<int> timedGenerator(int count, std::chrono::milliseconds interval) {
+    for (int i = 0; i < count; ++i) {
+        co_await QCoro::sleepFor(interval);
+        co_yield i;
+    }
+}
+
+QCoro::Task<> collect(QCoro::AsyncGenerator<const int &> generator, std::vector<int> &values) {
+    QCORO_FOREACH(int value, generator) {
+        values.push_back(value);
+    }
+}
+
+} // namespace
+
+class SharedAsyncGeneratorTest : public QCoro::TestObject<SharedAsyncGeneratorTest> {
+    Q_OBJECT
+private:
+    QCoro::Task<> testBroadcast_coro(QCoro::TestContext) {
+        auto shared = QCoro::share(timedGenerator(5, 10ms));
+
+        std::vector<int> first;
+        std::vector<int> second;
+        auto firstTask = collect(shared.subscribe(), first);
+        auto secondTask = collect(shared.subscribe(), second);
+        co_await firstTask;
+        co_await secondTask;
+
+        QCORO_COMPARE(first, (std::vector<int>{0, 1, 2, 3, 4}));
+        QCORO_COMPARE(second, (std::vector<int>{0, 1, 2, 3, 4}));
+    }
+
+    QCoro::Task<> testSharedValue_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        auto shared = syncGenerator(3) | QCoro::share();
+        auto first = shared.subscribe();
+        auto second = shared.subscribe();
+
+        auto firstIt = co_await first.begin();
+        auto secondIt = co_await second.begin();
+        QCORO_COMPARE(*firstIt, 0);
+        QCORO_COMPARE(&*firstIt, &*secondIt);
+    }
+
+    QCoro::Task<> testSlowConsumerBlock_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        std::vector<int> values;
+        int produced = 0;
+        auto shared = syncGenerator(10, &produced) | QCoro::share(3);
+        auto slow = shared.subscribe();
+        auto fastTask = collect(shared.subscribe(), values);
+
+        // The fast subscriber can only get 3 values ahead of the slow one
+        QCORO_COMPARE(values, (std::vector<int>{0, 1, 2}));
+        QCORO_COMPARE(produced, 3);
+
+        auto it = co_await slow.begin();
+        QCORO_COMPARE(*it, 0);
+        co_await ++it;
+        QCORO_COMPARE(*it, 1);
+        QCORO_COMPARE(values, (std::vector<int>{0, 1, 2, 3}));
+        QCORO_COMPARE(produced, 4);
+    }
+
+    QCoro::Task<> testSlowConsumerDropOldest_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        auto shared = syncGenerator(10) | QCoro::share(3, QCoro::SlowConsumerPolicy::DropOldest);
+        auto slow = shared.subscribe();
+
+        std::vector<int> fastValues;
+        co_await collect(shared.subscribe(), fastValues);
+        QCORO_COMPARE(fastValues, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+        std::vector<int> slowValues;
+        co_await collect(std::move(slow), slowValues);
+        QCORO_COMPARE(slowValues, (std::vector<int>{7, 8, 9}));
+    }
+
+    QCoro::Task<> testLateSubscriber_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        auto shared = syncGenerator(5) | QCoro::share();
+        auto early = shared.subscribe();
+        auto it = co_await early.begin();
+        co_await ++it;
+        QCORO_COMPARE(*it, 1);
+
+        std::vector<int> earlyValues;
+        std::vector<int> lateValues;
+        auto lateTask = collect(shared.subscribe(), lateValues);
+        while (it != early.end()) {
+            earlyValues.push_back(*it);
+            co_await ++it;
+        }
+        co_await lateTask;
+
+        QCORO_COMPARE(earlyValues, (std::vector<int>{1, 2, 3, 4}));
+        QCORO_COMPARE(lateValues, (std::vector<int>{2, 3, 4}));
+    }
+
+    QCoro::Task<> testException_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        const auto createGenerator = []() -> QCoro::AsyncGenerator<int> {
+            co_yield 1;
+            throw std::runtime_error("Broadcast this!");
+        };
+
+        auto shared = QCoro::share(createGenerator());
+        auto first = shared.subscribe();
+        auto second = shared.subscribe();
+
+        auto firstIt = co_await first.begin();
+        auto secondIt = co_await second.begin();
+        QCORO_COMPARE(*firstIt, 1);
+        QCORO_COMPARE(*secondIt, 1);
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await ++firstIt, std::runtime_error);
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await ++secondIt, std::runtime_error);
+    }
+
+    QCoro::Task<> testDestroySource_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        bool destroyed = false;
+        const auto createGenerator = [&destroyed]() -> QCoro::AsyncGenerator<int> {
+            const auto guard = qScopeGuard([&destroyed]() { destroyed = true; });
+            while (true) {
+                co_yield 42;
+            }
+        };
+
+        {
+            auto shared = QCoro::share(createGenerator());
+            auto subscriber = shared.subscribe();
+            const auto it = co_await subscriber.begin();
+            QCORO_COMPARE(*it, 42);
+            QCORO_VERIFY(!destroyed);
+        }
+
+        QCORO_VERIFY(destroyed);
+    }
+
+private Q_SLOTS:
+    addTest(Broadcast)
+    addTest(SharedValue)
+    addTest(SlowConsumerBlock)
+    addTest(SlowConsumerDropOldest)
+    addTest(LateSubscriber)
+    addTest(Exception)
+    addTest(DestroySource)
+};
+
+QTEST_GUILESS_MAIN(SharedAsyncGeneratorTest)
+
+#include "qcorosharedasyncgenerator.moc"
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcorosharedtask.h"
+#include "qcorotimer.h"
+
+#include <QString>
+
+#include <chrono>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class TestException : public std::runtime_error {
+public:
+    explicit TestException()
+        : std::runtime_error("TestException") {}
+};
+
+QCoro::SharedTask<QString> compute(int &computations) {
+    ++computations;
+    co_await QCoro::sleepFor(10ms);
+    co_return QStringLiteral("result");
+}
+
+QCoro::Task<const QString *> awaitShared(QCoro::SharedTask<QString> task) {
+    const auto &result = co_await task;
+    co_return &result;
+}
+
+} // namespace
+
+class QCoroSharedTaskTest : public QCoro::TestObject<QCoroSharedTaskTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testMultipleAwaiters_coro(QCoro::TestContext) {
+        int computations = 0;
+        const auto task = compute(computations);
+
+        std::vector<QCoro::Task<const QString *>> awaiters;
+        for (int i = 0; i < 3; ++i) {
+            awaiters.push_back(awaitShared(task));
+        }
+
+        std::vector<const QString *> results;
+        for (auto &awaiter : awaiters) {
+            results.push_back(co_await awaiter);
+        }
+        QCORO_COMPARE(computations, 1);
+        // All awaiters got a reference to the same result
+        QCORO_COMPARE(*results[0], QStringLiteral("result"));
+        QCORO_COMPARE(results[1], results[0]);
+        QCORO_COMPARE(results[2], results[0]);
+    }
+
+    QCoro::Task<> testAwaitFinished_coro(QCoro::TestContext context) {
+        int computations = 0;
+        const auto task = compute(computations);
+        const auto first = co_await task;
+        QCORO_VERIFY(task.isReady());
+
+        context.setShouldNotSuspend();
+        const auto second = co_await task;
+        QCORO_COMPARE(second, first);
+        QCORO_COMPARE(computations, 1);
+    }
+
+    QCoro::Task<> testCopies_coro(QCoro::TestContext) {
+        int computations = 0;
+        QCoro::SharedTask<QString> copy;
+        {
+            const auto task = compute(computations);
+            copy = task;
+        }
+        // The copy keeps the coroutine alive
+        const auto &result = co_await copy;
+        QCORO_COMPARE(result, QStringLiteral("result"));
+        QCORO_COMPARE(computations, 1);
+    }
+
+    QCoro::Task<> testCheapResultByValue_coro(QCoro::TestContext) {
+        const auto task = []() -> QCoro::SharedTask<int> {
+            co_await QCoro::sleepFor(1ms);
+            co_return 42;
+        }();
+        static_assert(std::is_same_v<decltype(task.operator co_await().await_resume()), int>);
+
+        const int first = co_await task;
+        const int second = co_await task;
+        QCORO_COMPARE(first, 42);
+        QCORO_COMPARE(second, 42);
+    }
+
+    QCoro::Task<> testTemporaryResultByValue_coro(QCoro::TestContext) {
+        int computations = 0;
+        static_assert(std::is_same_v<decltype(compute(computations).operator co_await().await_resume()), QString>);
+
+        // The temporary SharedTask is destroyed at the end of the statement, so the reference
+        // must be bound to a copy of the result rather than to the result in the coroutine
+        const auto &result = co_await compute(computations);
+        QCORO_COMPARE(result, QStringLiteral("result"));
+        QCORO_COMPARE(computations, 1);
+    }
+
+    QCoro::Task<> testVoid_coro(QCoro::TestContext) {
+        int runs = 0;
+        const auto task = [](int &runs) -> QCoro::SharedTask<> {
+            co_await QCoro::sleepFor(1ms);
+            ++runs;
+        }(runs);
+
+        co_await task;
+        co_await task;
+        QCORO_COMPARE(runs, 1);
+    }
+
+    QCoro::Task<> testException_coro(QCoro::TestContext) {
+        const auto task = []() -> QCoro::SharedTask<QString> {
+            co_await QCoro::sleepFor(1ms);
+            throw TestException();
+        }();
+
+        // The exception is re-thrown to every awaiter
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await task, TestException);
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await task, TestException);
+    }
+
+    QCoro::Task<> testToSharedTask_coro(QCoro::TestContext) {
+        auto task = QCoro::toSharedTask([]() -> QCoro::Task<QString> {
+            co_await QCoro::sleepFor(1ms);
+            co_return QStringLiteral("converted");
+        }());
+
+        const auto first = co_await task;
+        const auto second = co_await task;
+        QCORO_COMPARE(first, QStringLiteral("converted"));
+        QCORO_COMPARE(second, QStringLiteral("converted"));
+    }
+
+private Q_SLOTS:
+    addTest(MultipleAwaiters)
+    addTest(AwaitFinished)
+    addTest(Copies)
+    addTest(CheapResultByValue)
+    addTest(TemporaryResultByValue)
+    addTest(Void)
+    addTest(Exception)
+    addTest(ToSharedTask)
+};
+
+QTEST_GUILESS_MAIN(QCoroSharedTaskTest)
+
+#include "qcorosharedtask.moc"
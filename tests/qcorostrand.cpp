@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcorostrand.h"
+#include "qcorothread.h"
+#include "qcorotimer.h"
+
+#include <QScopeGuard>
+#include <QThread>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct SharedState {
+    QCoro::Strand strand;
+    // Only accessed inside of the strand, so it's deliberately not atomic
+    int counter = 0;
+    std::atomic<int> inside{0};
+    std::atomic<int> violations{0};
+};
+
+QCoro::Task<> increment(SharedState &state, QThread *thread, QThread *mainThread, int iterations) {
+    co_await QCoro::moveToThread(thread);
+    for (int i = 0; i < iterations; ++i) {
+        const auto guard = co_await state.strand.enter();
+        if (state.inside.fetch_add(1) != 0) {
+            ++state.violations;
+        }
+        ++state.counter;
+        state.inside.fetch_sub(1);
+    }
+    // Finish in the main thread, so that the test is resumed there
+    co_await QCoro::moveToThread(mainThread);
+}
+
+QCoro::Task<> enterAndRecord(QCoro::Strand &strand, std::vector<int> &order, int id) {
+    const auto guard = co_await strand.enter();
+    order.push_back(id);
+}
+
+} // namespace
+
+class QCoroStrandTest : public QCoro::TestObject<QCoroStrandTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testEnterFree_coro(QCoro::TestContext) {
+        QCoro::Strand strand;
+        {
+            const auto guard = co_await strand.enter();
+            QCORO_VERIFY(guard.ownsStrand());
+            QCORO_VERIFY(!strand.tryEnter().has_value());
+        }
+        QCORO_VERIFY(strand.tryEnter().has_value());
+    }
+
+    QCoro::Task<> testFifoOrder_coro(QCoro::TestContext) {
+        QCoro::Strand strand;
+        std::vector<int> order;
+
+        auto guard = strand.tryEnter();
+        QCORO_VERIFY(guard.has_value());
+        auto first = enterAndRecord(strand, order, 1);
+        auto second = enterAndRecord(strand, order, 2);
+        auto third = enterAndRecord(strand, order, 3);
+        QCORO_VERIFY(order.empty());
+
+        // Leaving the strand resumes all the waiters one by one
+        guard->leave();
+        QCORO_VERIFY(!guard->ownsStrand());
+        QCORO_COMPARE(order, (std::vector<int>{1, 2, 3}));
+        QCORO_VERIFY(first.isReady());
+        QCORO_VERIFY(third.isReady());
+        co_await first;
+        co_await second;
+        co_await third;
+        QCORO_VERIFY(strand.tryEnter().has_value());
+    }
+
+    QCoro::Task<> testLongQueue_coro(QCoro::TestContext) {
+        QCoro::Strand strand;
+        std::vector<int> order;
+
+        // Waiters that don't suspend inside the strand must not resume each other recursively
+        constexpr int count = 100'000;
+        auto guard = strand.tryEnter();
+        std::vector<QCoro::Task<>> waiters;
+        waiters.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            waiters.push_back(enterAndRecord(strand, order, i));
+        }
+
+        guard->leave();
+        QCORO_COMPARE(order.size(), static_cast<std::size_t>(count));
+        QCORO_COMPARE(order.back(), count - 1);
+        QCORO_VERIFY(strand.tryEnter().has_value());
+        co_return;
+    }
+
+    QCoro::Task<> testKeptAcrossSuspension_coro(QCoro::TestContext) {
+        QCoro::Strand strand;
+        std::vector<int> order;
+
+        auto holder = [](QCoro::Strand &strand, std::vector<int> &order) -> QCoro::Task<> {
+            const auto guard = co_await strand.enter();
+            co_await QCoro::sleepFor(10ms);
+            order.push_back(1);
+        }(strand, order);
+        auto waiter = enterAndRecord(strand, order, 2);
+
+        co_await holder;
+        co_await waiter;
+        QCORO_COMPARE(order, (std::vector<int>{1, 2}));
+    }
+
+    QCoro::Task<> testGuardMove_coro(QCoro::TestContext) {
+        QCoro::Strand strand;
+        QCoro::StrandGuard outer;
+        QCORO_VERIFY(!outer.ownsStrand());
+        {
+            auto guard = co_await strand.enter();
+            outer = std::move(guard);
+            QCORO_VERIFY(!guard.ownsStrand());
+        }
+        // The moved-from guard didn't leave the strand
+        QCORO_VERIFY(outer.ownsStrand());
+        QCORO_VERIFY(!strand.tryEnter().has_value());
+        outer.leave();
+        QCORO_VERIFY(strand.tryEnter().has_value());
+    }
+
+    QCoro::Task<> testMultipleThreads_coro(QCoro::TestContext) {
+        constexpr int threadCount = 4;
+        constexpr int iterations = 10'000;
+
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.push_back(std::make_unique<QThread>());
+            threads.back()->start();
+        }
+        const auto threadsGuard = qScopeGuard([&threads]() {
+            for (auto &thread : threads) {
+                thread->quit();
+                thread->wait();
+            }
+        });
+
+        SharedState state;
+        std::vector<QCoro::Task<>> tasks;
+        for (auto &thread : threads) {
+            tasks.push_back(increment(state, thread.get(), QThread::currentThread(), iterations));
+        }
+        for (auto &task : tasks) {
+            co_await task;
+        }
+
+        QCORO_COMPARE(state.violations.load(), 0);
+        QCORO_COMPARE(state.counter, threadCount * iterations);
+    }
+
+private Q_SLOTS:
+    addTest(EnterFree)
+    addTest(FifoOrder)
+    addTest(LongQueue)
+    addTest(KeptAcrossSuspension)
+    addTest(GuardMove)
+    addTest(MultipleThreads)
+};
+
+QTEST_GUILESS_MAIN(QCoroStrandTest)
+
+#include "qcorostrand.moc"
@@ -118,9 +118,47 @@ private:
         QCORO_VERIFY(ok);
     }
 
+    QCoro::Task<> testTryWaitForNewConnection_coro(QCoro::TestContext) {
+        QTcpServer server;
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+        const quint16 serverPort = server.serverPort();
+
+        std::mutex mutex;
+        bool ok = false;
+        Client client(serverPort, mutex, ok);
+
+        const auto connection = co_await qCoro(server).tryWaitForNewConnection(10s);
+        QCORO_VERIFY(connection.has_value());
+        QCORO_VERIFY(*connection != nullptr);
+
+        std::lock_guard lock{mutex};
+        QCORO_VERIFY(ok);
+    }
+
+    QCoro::Task<> testTryWaitForNewConnectionTimeout_coro(QCoro::TestContext) {
+        QTcpServer server;
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+
+        const auto connection = co_await qCoro(server).tryWaitForNewConnection(10ms);
+        QCORO_VERIFY(!connection.has_value());
+        QCORO_COMPARE(connection.error(), QAbstractSocket::SocketTimeoutError);
+    }
+
+    QCoro::Task<> testTryWaitForNewConnectionNotListening_coro(QCoro::TestContext testContext) {
+        testContext.setShouldNotSuspend();
+
+        QTcpServer server;
+        const auto connection = co_await qCoro(server).tryWaitForNewConnection(10s);
+        QCORO_VERIFY(!connection.has_value());
+        QCORO_COMPARE(connection.error(), server.serverError());
+    }
+
 private Q_SLOTS:
     addCoroAndThenTests(WaitForNewConnectionTriggers)
     addTest(DoesntCoAwaitPendingConnection)
+    addTest(TryWaitForNewConnection)
+    addTest(TryWaitForNewConnectionTimeout)
+    addTest(TryWaitForNewConnectionNotListening)
 };
 
 QTEST_GUILESS_MAIN(QCoroTcpServerTest)
@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcorotracing.h"
+#include "qcorotracers.h"
+#include "qcorosignal.h"
+#include "qcorothread.h"
+#include "qcorotimer.h"
+#include "qcoroiodevice.h"
+
+#include <QBuffer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QScopeGuard>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QTimer>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+QCoro::Task<> sleeper() {
+    co_await QCoro::sleepFor(20ms);
+}
+
+QCoro::Task<> awaitTimeout() {
+    QTimer timer;
+    timer.setSingleShot(true);
+    timer.start(20ms);
+    co_await qCoro(&timer, &QTimer::timeout);
+}
+
+class Emitter : public QObject {
+    Q_OBJECT
+Q_SIGNALS:
+    void emitted();
+};
+
+QCoro::Task<> awaitSignal() {
+    Emitter emitter;
+    QTimer::singleShot(20ms, &emitter, &Emitter::emitted);
+    co_await qCoro(&emitter, &Emitter::emitted);
+}
+
+} // namespace
+
+class QCoroTracingTest : public QCoro::TestObject<QCoroTracingTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testLatencyHistogram_coro(QCoro::TestContext) {
+        QCoro::LatencyHistogram histogram;
+        QCORO_COMPARE(histogram.count(), quint64{0});
+        QCORO_VERIFY(histogram.percentile(50.0) == 0ns);
+
+        for (int i = 1; i <= 1000; ++i) {
+            histogram.record(std::chrono::microseconds{i});
+        }
+
+        QCORO_COMPARE(histogram.count(), quint64{1000});
+        QCORO_VERIFY(histogram.min() == 1us);
+        QCORO_VERIFY(histogram.max() == 1000us);
+        QCORO_VERIFY(histogram.mean() == 500500ns);
+        // The reported percentile is never lower than the actual value and is off by at most 1/32
+        const auto p50 = histogram.percentile(50.0);
+        QCORO_VERIFY(p50 >= 500us && p50 <= 500us + 500us / 32);
+        const auto p99 = histogram.percentile(99.0);
+        QCORO_VERIFY(p99 >= 990us && p99 <= 990us + 990us / 32);
+        QCORO_VERIFY(histogram.percentile(100.0) == 1000us);
+
+        histogram.reset();
+        QCORO_COMPARE(histogram.count(), quint64{0});
+        QCORO_VERIFY(histogram.max() == 0ns);
+    }
+
+    QCoro::Task<> testHistogramTracer_coro(QCoro::TestContext) {
+        if (!QCoro::Tracing::isEnabled()) {
+            QCORO_SKIP("QCoro was built without tracing");
+        }
+
+        QCoro::HistogramTracer tracer;
+        QCoro::Tracing::setTracer(&tracer);
+        const auto guard = qScopeGuard([]() { QCoro::Tracing::setTracer(nullptr); });
+
+        co_await sleeper();
+        co_await awaitTimeout();
+        co_await awaitSignal();
+
+        const auto &tasks = tracer.histogram(QCoro::Tracing::SuspensionKind::Task);
+        QCORO_VERIFY(tasks.count() >= 3);
+        QCORO_VERIFY(tasks.max() >= 20ms);
+        // Both the sleep and the QTimer::timeout signal are timers
+        const auto &timers = tracer.histogram(QCoro::Tracing::SuspensionKind::Timer);
+        QCORO_COMPARE(timers.count(), quint64{2});
+        QCORO_VERIFY(timers.min() >= 15ms);
+        const auto &signalWaits = tracer.histogram(QCoro::Tracing::SuspensionKind::Signal);
+        QCORO_COMPARE(signalWaits.count(), quint64{1});
+        QCORO_VERIFY(signalWaits.min() >= 15ms);
+
+        tracer.dump();
+        tracer.reset();
+        QCORO_COMPARE(tracer.histogram(QCoro::Tracing::SuspensionKind::Task).count(), quint64{0});
+    }
+
+    QCoro::Task<> testThread_coro(QCoro::TestContext) {
+        if (!QCoro::Tracing::isEnabled()) {
+            QCORO_SKIP("QCoro was built without tracing");
+        }
+
+        QThread thread;
+        thread.start();
+        const auto threadGuard = qScopeGuard([&thread]() {
+            thread.quit();
+            thread.wait();
+        });
+
+        QCoro::HistogramTracer tracer;
+        QCoro::Tracing::setTracer(&tracer);
+        const auto guard = qScopeGuard([]() { QCoro::Tracing::setTracer(nullptr); });
+
+        co_await QCoro::moveToThread(&thread);
+        co_await QCoro::moveToThread(qApp->thread());
+
+        QCORO_COMPARE(tracer.histogram(QCoro::Tracing::SuspensionKind::Thread).count(), quint64{2});
+    }
+
+    QCoro::Task<> testIODevice_coro(QCoro::TestContext) {
+        if (!QCoro::Tracing::isEnabled()) {
+            QCORO_SKIP("QCoro was built without tracing");
+        }
+
+        QCoro::HistogramTracer tracer;
+        QCoro::Tracing::setTracer(&tracer);
+        const auto guard = qScopeGuard([]() { QCoro::Tracing::setTracer(nullptr); });
+
+        QBuffer buffer;
+        QCORO_VERIFY(buffer.open(QIODevice::ReadWrite));
+        QTimer::singleShot(10ms, &buffer, [&buffer]() { buffer.write("data"); });
+        const bool ready = co_await qCoro(buffer).waitForReadyRead(10s);
+        QCORO_VERIFY(ready);
+
+        // Waiting for the device goes through a helper signal, but is still traced as I/O
+        QCORO_VERIFY(tracer.histogram(QCoro::Tracing::SuspensionKind::IODevice).count() >= 1);
+        QCORO_COMPARE(tracer.histogram(QCoro::Tracing::SuspensionKind::Signal).count(), quint64{0});
+    }
+
+    QCoro::Task<> testUninstalledTracer_coro(QCoro::TestContext) {
+        if (!QCoro::Tracing::isEnabled()) {
+            QCORO_SKIP("QCoro was built without tracing");
+        }
+
+        QCoro::HistogramTracer tracer;
+        QCoro::Tracing::setTracer(&tracer);
+        auto task = sleeper();
+        QCoro::Tracing::setTracer(nullptr);
+        QCORO_VERIFY(QCoro::Tracing::tracer() == nullptr);
+
+        co_await task;
+        QCORO_COMPARE(tracer.histogram(QCoro::Tracing::SuspensionKind::Task).count(), quint64{0});
+    }
+
+    QCoro::Task<> testChromeTrace_coro(QCoro::TestContext) {
+        if (!QCoro::Tracing::isEnabled()) {
+            QCORO_SKIP("QCoro was built without tracing");
+        }
+
+        QCoro::ChromeTraceTracer tracer(2);
+        QCoro::Tracing::setTracer(&tracer);
+        const auto guard = qScopeGuard([]() { QCoro::Tracing::setTracer(nullptr); });
+
+        co_await awaitTimeout();
+        co_await awaitTimeout();
+        co_await awaitTimeout();
+        QCoro::Tracing::setTracer(nullptr);
+
+        QCORO_COMPARE(tracer.eventCount(), std::size_t{2});
+        QCORO_VERIFY(tracer.droppedEventCount() > 0);
+
+        QTemporaryDir dir;
+        QCORO_VERIFY(dir.isValid());
+        const auto fileName = dir.filePath(QStringLiteral("trace.json"));
+        QCORO_VERIFY(tracer.save(fileName));
+
+        QFile file(fileName);
+        QCORO_VERIFY(file.open(QIODevice::ReadOnly));
+        QJsonParseError error;
+        const auto doc = QJsonDocument::fromJson(file.readAll(), &error);
+        QCORO_COMPARE(error.error, QJsonParseError::NoError);
+
+        const auto events = doc.object()[QStringLiteral("traceEvents")].toArray();
+        int spans = 0;
+        for (const auto &value : events) {
+            const auto event = value.toObject();
+            if (event[QStringLiteral("ph")].toString() != QLatin1String("X")) {
+                continue;
+            }
+            ++spans;
+            QCORO_VERIFY(event[QStringLiteral("dur")].toDouble() > 0.0);
+            QCORO_VERIFY(event[QStringLiteral("tid")].toInt() > 0);
+            QCORO_VERIFY(event[QStringLiteral("args")].toObject().contains(QStringLiteral("coroutine")));
+        }
+        QCORO_COMPARE(spans, 2);
+
+        tracer.clear();
+        QCORO_COMPARE(tracer.eventCount(), std::size_t{0});
+    }
+
+private Q_SLOTS:
+    addTest(LatencyHistogram)
+    addTest(HistogramTracer)
+    addTest(Thread)
+    addTest(IODevice)
+    addTest(UninstalledTracer)
+    addTest(ChromeTrace)
+};
+
+QTEST_GUILESS_MAIN(QCoroTracingTest)
+
+#include "qcorotracing.moc"
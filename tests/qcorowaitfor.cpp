@@ -4,9 +4,14 @@
 
 #include "testobject.h"
 
+#include "qcorothread.h"
 #include "qcorotimer.h"
 
+#include <QThread>
+
 #include <chrono>
+#include <memory>
+#include <stdexcept>
 
 class QCoroWaitForTest : public QCoro::TestObject<QCoroWaitForTest> {
     Q_OBJECT
@@ -51,10 +56,72 @@ private:
         QCORO_VERIFY(ret.i == 7);
     }
 
+    QCoro::Task<void> testBlockingMode_coro(QCoro::TestContext)
+    {
+        auto *mainThread = QThread::currentThread();
+        const auto task_test = [mainThread]() -> QCoro::Task<int> {
+            co_await QCoro::moveToThread(mainThread);
+            co_await QCoro::sleepFor(10ms);
+            co_return 7;
+        };
+
+        int ret = 0;
+        std::unique_ptr<QThread> thread(QThread::create([&]() {
+            ret = QCoro::waitFor(task_test(), QCoro::WaitMode::Blocking);
+        }));
+        thread->start();
+        co_await qCoro(thread.get()).waitForFinished();
+
+        QCORO_COMPARE(ret, 7);
+    }
+
+    QCoro::Task<void> testBlockingModeException_coro(QCoro::TestContext)
+    {
+        auto *mainThread = QThread::currentThread();
+        const auto task_test = [mainThread]() -> QCoro::Task<> {
+            co_await QCoro::moveToThread(mainThread);
+            throw std::runtime_error("Booom");
+        };
+
+        bool thrown = false;
+        std::unique_ptr<QThread> thread(QThread::create([&]() {
+            try {
+                QCoro::waitFor(task_test(), QCoro::WaitMode::Blocking);
+            } catch (const std::runtime_error &) {
+                thrown = true;
+            }
+        }));
+        thread->start();
+        co_await qCoro(thread.get()).waitForFinished();
+
+        QCORO_VERIFY(thrown);
+    }
+
+    QCoro::Task<void> testEventLoopModeFromThread_coro(QCoro::TestContext)
+    {
+        auto *mainThread = QThread::currentThread();
+        const auto task_test = [mainThread]() -> QCoro::Task<int> {
+            co_await QCoro::moveToThread(mainThread);
+            co_return 7;
+        };
+
+        int ret = 0;
+        std::unique_ptr<QThread> thread(QThread::create([&]() {
+            ret = QCoro::waitFor(task_test(), QCoro::WaitMode::EventLoop);
+        }));
+        thread->start();
+        co_await qCoro(thread.get()).waitForFinished();
+
+        QCORO_COMPARE(ret, 7);
+    }
+
 private Q_SLOTS:
     addTest(PrimitiveType)
     addTest(DefaultConstructible)
     addTest(NonDefaultConstructible)
+    addTest(BlockingMode)
+    addTest(BlockingModeException)
+    addTest(EventLoopModeFromThread)
 };
 
 QTEST_GUILESS_MAIN(QCoroWaitForTest)
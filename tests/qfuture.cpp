@@ -5,9 +5,12 @@
 #include "testobject.h"
 
 #include "qcorofuture.h"
+#include "qcorosignal.h"
+#include "qcorotimer.h"
 
 #include <QString>
 #include <QException>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include <QPromise>
 
@@ -263,6 +266,138 @@ private:
         co_await future;
     }
 
+    QCoro::Task<> testMultipleAwaiters_coro(QCoro::TestContext) {
+        QPromise<int> promise;
+        auto future = promise.future();
+
+        const auto awaiter = [](QFuture<int> future) -> QCoro::Task<int> {
+            co_return co_await future;
+        };
+        auto first = awaiter(future);
+        auto second = awaiter(future);
+
+        QTimer::singleShot(10ms, this, [&promise]() {
+            promise.start();
+            promise.addResult(42);
+            promise.finish();
+        });
+
+        QCORO_COMPARE(co_await first, 42);
+        QCORO_COMPARE(co_await second, 42);
+    }
+
+    QCoro::Task<> testResults_coro(QCoro::TestContext) {
+        QPromise<int> promise;
+        promise.start();
+        promise.addResult(1);
+
+        auto results = qCoro(promise.future()).results();
+        auto it = co_await results.begin();
+        QCORO_COMPARE(*it, 1);
+
+        QTimer::singleShot(10ms, this, [&promise]() {
+            promise.addResult(2);
+            promise.addResult(3);
+        });
+        co_await ++it;
+        QCORO_COMPARE(*it, 2);
+        co_await ++it;
+        QCORO_COMPARE(*it, 3);
+
+        QTimer::singleShot(10ms, this, [&promise]() {
+            promise.finish();
+        });
+        co_await ++it;
+        QCORO_VERIFY(it == results.end());
+    }
+
+    QCoro::Task<> testResultsConcurrent_coro(QCoro::TestContext) {
+        QList<int> input;
+        for (int i = 0; i < 1000; ++i) {
+            input.push_back(i);
+        }
+
+        QList<int> output;
+        QCORO_FOREACH(int value, qCoro(QtConcurrent::mapped(input, [](int value) { return value * 2; })).results()) {
+            output.push_back(value);
+        }
+
+        QCORO_COMPARE(output.size(), input.size());
+        for (int i = 0; i < input.size(); ++i) {
+            QCORO_COMPARE(output[i], input[i] * 2);
+        }
+    }
+
+    QCoro::Task<> testResultsException_coro(QCoro::TestContext) {
+        QPromise<int> promise;
+        promise.start();
+        promise.addResult(42);
+        QTimer::singleShot(10ms, this, [&promise]() {
+            promise.setException(std::make_exception_ptr(std::runtime_error("Booom")));
+            promise.finish();
+        });
+
+        auto results = qCoro(promise.future()).results();
+        auto it = co_await results.begin();
+        QCORO_COMPARE(*it, 42);
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await ++it, std::runtime_error);
+    }
+
+    QCoro::Task<> testToFuture_coro(QCoro::TestContext) {
+        const auto task = []() -> QCoro::Task<int> {
+            co_await QCoro::sleepFor(10ms);
+            co_return 42;
+        };
+
+        auto future = QCoro::toFuture(task());
+        QCORO_VERIFY(!future.isFinished());
+        QCORO_COMPARE(co_await future, 42);
+    }
+
+    QCoro::Task<> testToFutureVoid_coro(QCoro::TestContext) {
+        bool done = false;
+        const auto task = [&done]() -> QCoro::Task<> {
+            co_await QCoro::sleepFor(10ms);
+            done = true;
+        };
+
+        QFutureWatcher<void> watcher;
+        watcher.setFuture(QCoro::toFuture(task()));
+        co_await qCoro(&watcher, &QFutureWatcherBase::finished);
+        QCORO_VERIFY(done);
+    }
+
+    QCoro::Task<> testToFutureException_coro(QCoro::TestContext) {
+        const auto task = []() -> QCoro::Task<int> {
+            co_await QCoro::sleepFor(10ms);
+            throw std::runtime_error("Booom");
+        };
+
+        QCORO_VERIFY_EXCEPTION_THROWN(co_await QCoro::toFuture(task()), std::runtime_error);
+    }
+
+    QCoro::Task<> testToFutureCanceled_coro(QCoro::TestContext) {
+        bool done = false;
+        const auto task = [&done]() -> QCoro::Task<int> {
+            co_await QCoro::sleepFor(100ms);
+            done = true;
+            co_return 42;
+        };
+
+        auto future = QCoro::toFuture(task());
+        QTimer::singleShot(10ms, this, [future]() mutable { future.cancel(); });
+        // The canceled future has no result, so wait for it to finish rather than co_awaiting it
+        QFutureWatcher<int> watcher;
+        watcher.setFuture(future);
+        co_await qCoro(&watcher, &QFutureWatcherBase::finished);
+        QCORO_VERIFY(future.isCanceled());
+        QCORO_VERIFY(!done);
+
+        co_await QCoro::sleepFor(200ms);
+        QCORO_VERIFY(done);
+        QCORO_COMPARE(future.resultCount(), 0);
+    }
+
 private Q_SLOTS:
     // Regression test for #312: verify that destroying a task while it is
     // awaiting on a QFuture doesn't cause a crash or memory leak
@@ -308,6 +443,14 @@ private Q_SLOTS:
     addTest(PropagateStdExceptionFromNonvoidPromise)
     addCoroAndThenTests(TakeResult)
     addTest(UnfinishedPromiseDestroyed)
+    addTest(MultipleAwaiters)
+    addTest(Results)
+    addTest(ResultsConcurrent)
+    addTest(ResultsException)
+    addTest(ToFuture)
+    addTest(ToFutureVoid)
+    addTest(ToFutureException)
+    addTest(ToFutureCanceled)
 };
 
 QTEST_GUILESS_MAIN(QCoroFutureTest)
@@ -7,8 +7,10 @@
 #include "qcorotimer.h"
 
 #include <chrono>
+#include <vector>
 
 #include <QElapsedTimer>
+#include <QThread>
 
 using namespace std::chrono_literals;
 
@@ -88,6 +90,111 @@ private:
         QCORO_VERIFY(elapsed.elapsed() >= 475);
     }
 
+    QCoro::Task<> testSleepForOrder_coro(QCoro::TestContext) {
+        std::vector<int> order;
+        const auto sleep = [&order](int ms) -> QCoro::Task<> {
+            co_await QCoro::sleepFor(std::chrono::milliseconds(ms));
+            order.push_back(ms);
+        };
+
+        auto slow = sleep(60);
+        auto fast = sleep(20);
+        auto zero = sleep(0);
+        auto medium = sleep(40);
+        co_await slow;
+
+        QCORO_COMPARE(order, (std::vector<int>{0, 20, 40, 60}));
+    }
+
+    QCoro::Task<> testSleepForInNestedEventLoop_coro(QCoro::TestContext) {
+        co_await QCoro::sleepFor(1ms);
+        // Resumed by the timer queue, which must still be armed for sleeps in a nested event loop
+        QElapsedTimer elapsed;
+        elapsed.start();
+        QCoro::waitFor(QCoro::sleepFor(10ms));
+        QCORO_VERIFY(elapsed.elapsed() >= 5);
+    }
+
+    //! Returns the first \c count ticks, with a slow consumer after the first tick.
+    static QCoro::Task<std::vector<std::chrono::steady_clock::time_point>> intervalTicks(QCoro::MissedTickPolicy policy, int count) {
+        auto ticker = QCoro::interval(50ms, policy);
+        std::vector<std::chrono::steady_clock::time_point> ticks;
+        auto it = co_await ticker.begin();
+        while (true) {
+            ticks.push_back(*it);
+            if (static_cast<int>(ticks.size()) == count) {
+                break;
+            }
+            if (ticks.size() == 1) {
+                QThread::msleep(120);
+            }
+            co_await ++it;
+        }
+        co_return ticks;
+    }
+
+    QCoro::Task<> testInterval_coro(QCoro::TestContext) {
+        const auto start = std::chrono::steady_clock::now();
+        auto ticker = QCoro::interval(20ms);
+        int count = 0;
+        QCORO_FOREACH(const auto &tick, ticker) {
+            ++count;
+            // The ticks are scheduled on a fixed grid and never happen before they are scheduled
+            QCORO_VERIFY(tick - start >= count * 20ms);
+            QCORO_VERIFY(std::chrono::steady_clock::now() >= tick);
+            if (count == 5) {
+                break;
+            }
+        }
+    }
+
+    QCoro::Task<> testIntervalStartsOnCreation_coro(QCoro::TestContext) {
+        const auto start = std::chrono::steady_clock::now();
+        auto ticker = QCoro::interval(50ms, QCoro::MissedTickPolicy::Burst);
+        co_await QCoro::sleepFor(120ms);
+
+        // The ticks are scheduled relative to the call to interval(), not to the first begin()
+        auto it = co_await ticker.begin();
+        QCORO_VERIFY(*it - start >= 50ms);
+        QCORO_VERIFY(*it - start < 100ms);
+        co_await ++it;
+        QCORO_VERIFY(*it - start >= 100ms);
+        QCORO_VERIFY(*it - start < 150ms);
+    }
+
+    QCoro::Task<> testIntervalSkip_coro(QCoro::TestContext) {
+        const auto ticks = co_await intervalTicks(QCoro::MissedTickPolicy::Skip, 3);
+        // Ticks at 100ms and 150ms are missed
+        QCORO_VERIFY(ticks[1] - ticks[0] == 150ms);
+        QCORO_VERIFY(ticks[2] - ticks[1] == 50ms);
+    }
+
+    QCoro::Task<> testIntervalBurst_coro(QCoro::TestContext) {
+        const auto ticks = co_await intervalTicks(QCoro::MissedTickPolicy::Burst, 4);
+        QCORO_VERIFY(ticks[1] - ticks[0] == 50ms);
+        QCORO_VERIFY(ticks[2] - ticks[1] == 50ms);
+        QCORO_VERIFY(ticks[3] - ticks[2] == 50ms);
+    }
+
+    QCoro::Task<> testIntervalDelay_coro(QCoro::TestContext) {
+        const auto ticks = co_await intervalTicks(QCoro::MissedTickPolicy::Delay, 3);
+        // The next tick happens a full period after the slow consumer asks for it
+        QCORO_VERIFY(ticks[1] - ticks[0] >= 165ms);
+        QCORO_VERIFY(ticks[2] - ticks[1] == 50ms);
+    }
+
+    QCoro::Task<> testDestroyIntervalWhileWaiting_coro(QCoro::TestContext) {
+        {
+            auto ticker = QCoro::interval(20ms);
+            // Make the ticker wait for its first tick without suspending this coroutine
+            auto begin = ticker.begin();
+            begin.await_suspend(std::noop_coroutine()).resume();
+        } // The ticker is destroyed while waiting
+
+        // The destroyed ticker must not be resumed once its deadline passes. If it is, ASAN will catch it.
+        co_await QCoro::sleepFor(50ms);
+    }
+
 private Q_SLOTS:
     addTest(Triggers)
     addTest(QCoroWrapperTriggers)
@@ -96,6 +203,14 @@ private Q_SLOTS:
     addTest(DoesntCoAwaitNullTimer)
     addTest(SleepFor)
     addTest(SleepUntil)
+    addTest(SleepForOrder)
+    addTest(SleepForInNestedEventLoop)
+    addTest(Interval)
+    addTest(IntervalStartsOnCreation)
+    addTest(IntervalSkip)
+    addTest(IntervalBurst)
+    addTest(IntervalDelay)
+    addTest(DestroyIntervalWhileWaiting)
 
     addThenTest(Triggers)
 };